@@ -0,0 +1,142 @@
+#include "list.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+
+#define BENCH_COUNT ( 1 << 20 )
+#define BENCH_REGION ( (size_t)64 << 20 )
+
+typedef enum { BPRandom, BPSorted, BPReversed, BPFew, BPNum } bench_pattern_e;
+
+static const char * const aPatternName[] = { "random", "sorted", "reversed", "few unique" };
+
+static
+int
+_benchCompare(
+    void * pvLeft,
+    void * pvRight
+) {
+    const uint32_t uLeft = *(uint32_t const *)pvLeft;
+    const uint32_t uRight = *(uint32_t const *)pvRight;
+
+    return ( uLeft > uRight ) - ( uLeft < uRight );
+}
+
+static
+int
+_benchCompareQsort(
+    void const * pvLeft,
+    void const * pvRight
+) {
+    // ? qsort hands out pointers to the slots, the list hands out the values themselves
+    return _benchCompare(*(void * const *)pvLeft, *(void * const *)pvRight);
+}
+
+static
+void
+_benchNoFree(
+    void * pvValue
+) {
+    (void)pvValue;
+}
+
+static
+void
+_benchFill(
+    uint32_t * const auValue,
+    const bench_pattern_e ePattern
+) {
+    uint32_t uSeed = 2463534242u;
+    size_t idx = 0;
+
+    for ( idx = 0; idx < BENCH_COUNT; ++idx )
+    {
+        uSeed ^= uSeed << 13;
+        uSeed ^= uSeed >> 17;
+        uSeed ^= uSeed << 5;
+
+        switch ( ePattern )
+        {
+            case BPRandom: auValue[ idx ] = uSeed; break;
+            case BPSorted: auValue[ idx ] = (uint32_t)idx; break;
+            case BPReversed: auValue[ idx ] = (uint32_t)( BENCH_COUNT - idx ); break;
+            default: auValue[ idx ] = uSeed % 16; break;
+        }
+    }
+}
+
+static
+double
+_benchNanos(
+    struct timespec const * const psBegin,
+    struct timespec const * const psEnd
+) {
+    return ( psEnd->tv_sec - psBegin->tv_sec ) * 1e9 + ( psEnd->tv_nsec - psBegin->tv_nsec );
+}
+
+int
+main(
+    void
+) {
+    uint32_t * const auValue = (uint32_t *)malloc(BENCH_COUNT * sizeof(uint32_t));
+    void ** const apValue = (void **)malloc(BENCH_COUNT * sizeof(void *));
+    pool_s * const psPool = poolMake(BENCH_REGION, PMSegregate, PFNone);
+    list_s * psList = NULL;
+    struct timespec sBegin, sEnd;
+    double dQuick = 0;
+    double dStable = 0;
+    double dQsort = 0;
+    size_t idx = 0;
+    int ePattern = 0;
+
+    if ( NULL == auValue || NULL == apValue || NULL == psPool )
+    {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+
+    printf("%-12s %10s %14s %14s %14s\n", "pattern", "elements", "quick ms", "stable ms", "qsort ms");
+    for ( ePattern = BPRandom; ePattern < BPNum; ++ePattern )
+    {
+        // ? each sort gets the same input, the list is rebuilt in between and its build is not timed
+        _benchFill(auValue, (bench_pattern_e)ePattern);
+        psList = listMake(psPool, _benchNoFree);
+        for ( idx = 0; idx < BENCH_COUNT; ++idx )
+        {
+            listInsert(psList, ~(size_t)0, &auValue[ idx ]);
+        }
+        timespec_get(&sBegin, TIME_UTC);
+        listQuickSort(psList, _benchCompare);
+        timespec_get(&sEnd, TIME_UTC);
+        dQuick = _benchNanos(&sBegin, &sEnd);
+        listFree(psList);
+
+        psList = listMake(psPool, _benchNoFree);
+        for ( idx = 0; idx < BENCH_COUNT; ++idx )
+        {
+            listInsert(psList, ~(size_t)0, &auValue[ idx ]);
+        }
+        timespec_get(&sBegin, TIME_UTC);
+        listStableSort(psList, _benchCompare);
+        timespec_get(&sEnd, TIME_UTC);
+        dStable = _benchNanos(&sBegin, &sEnd);
+        listFree(psList);
+
+        for ( idx = 0; idx < BENCH_COUNT; ++idx )
+        {
+            apValue[ idx ] = &auValue[ idx ];
+        }
+        timespec_get(&sBegin, TIME_UTC);
+        qsort(apValue, BENCH_COUNT, sizeof(void *), _benchCompareQsort);
+        timespec_get(&sEnd, TIME_UTC);
+        dQsort = _benchNanos(&sBegin, &sEnd);
+
+        printf("%-12s %10d %14.2f %14.2f %14.2f\n", aPatternName[ ePattern ], BENCH_COUNT, dQuick / 1e6, dStable / 1e6, dQsort / 1e6);
+    }
+
+    poolFree(psPool);
+    free(apValue);
+    free(auValue);
+    return 0;
+}
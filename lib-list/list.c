@@ -1,32 +1,73 @@
 #include <assert.h>
 #include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
 
 #include "list.h"
 
-typedef struct node_s node_s;
-struct node_s
+#define LIST_CHUNK_SLOTS ( 30 ) /* a chunk is 256 bytes, four cache lines */
+#define LIST_INDEX_STRIDE ( 4 ) /* chunks between two index entries */
+#define LIST_INDEX_REACH ( 2 * LIST_INDEX_STRIDE * LIST_CHUNK_SLOTS ) /* closer than this the cursor walks */
+
+/* the values are unrolled into chunks, zXor links the chunks like it used to link single values */
+typedef struct chunk_s chunk_s;
+struct chunk_s
 {
-    void * pvValue;
     size_t zXor;
+    size_t zCount;
+    void * apValue[ LIST_CHUNK_SLOTS ];
 };
 
+/* a cursor parked on every LIST_INDEX_STRIDE-th chunk */
+typedef struct {
+    chunk_s * psPrev;
+    chunk_s * psCurr;
+    size_t zRecord;
+} mark_s;
+
+/* indexes are physical, bRevert flips them so listRevert stays O(1) */
 struct list_s
 {
     pool_s * const psPool;
+    slab_s * const psSlab;
     void (* const pfFree)(void *);
 
-    node_s * psHead;
-    node_s * psTail;
+    chunk_s * psHead;
+    chunk_s * psTail;
     size_t zLength;
+    bool bRevert;
 
-    node_s * psPrev;
-    node_s * psCurr;
-    node_s * psNext;
-    size_t zRecord;
+    chunk_s * psPrev; /* neighbour of psCurr on the head side */
+    chunk_s * psCurr;
+    size_t zRecord; /* index of the first value in psCurr */
+
+    mark_s * asMark; /* skip index, mended by every change, chunks behind the last mark are walked in by the next far access */
+    size_t zMarkCount;
+    size_t zMarkCapacity;
+    size_t zMarkDrift; /* chunks made or dropped since the index was built */
+    bool bMarkPartial;
 };
 
+static size_t _listPhysical(list_s const * const psRefs, const size_t zIndex, const bool bInsert);
 static bool _listTryAccess(list_s * const psRefs, const size_t zIndex);
-static void _listQuickSort(node_s * const psHead, node_s * const psTail, int (* const pfCompare)(void *, void *));
+static bool _listIndexSeek(list_s * const psRefs, const size_t zIndex);
+static bool _listIndexBuild(list_s * const psRefs, const size_t zIndex);
+static void _listIndexShift(list_s * const psRefs, const size_t zRecord, const bool bGrow);
+static void _listIndexRelink(list_s * const psRefs, const size_t zRecord, chunk_s * const psFrom, chunk_s * const psTo, chunk_s * const psGone);
+static chunk_s * _listChunkAfter(list_s * const psRefs, chunk_s * const psPrev, chunk_s * const psNext);
+static void _listChunkDrop(list_s * const psRefs, chunk_s * const psPrev, chunk_s * const psTarget);
+static bool _listBoundary(list_s * const psRefs, const size_t zIndex, chunk_s ** const ppsLeft, chunk_s ** const ppsRight);
+static void _listFlip(list_s * const psRefs);
+static void _listReindex(list_s * const psRefs);
+static void _listForget(list_s * const psRefs);
+static void ** _listGather(list_s * const psRefs);
+static void _listScatter(list_s * const psRefs, void ** const apValue);
+static void _listQuickSort(void ** const apValue, const size_t zCount, unsigned int uDepth, int (* const pfCompare)(void *, void *));
+static void _listHeapSort(void ** const apValue, const size_t zCount, int (* const pfCompare)(void *, void *));
+static void _listSiftDown(void ** const apValue, size_t zRoot, const size_t zEnd, int (* const pfCompare)(void *, void *));
+static void _listInsertSort(void ** const apValue, const size_t zCount, int (* const pfCompare)(void *, void *));
+static void ** _listMergeSort(void ** apValue, void ** apSpare, const size_t zCount, int (* const pfCompare)(void *, void *));
 
 /* public */
 list_s *
@@ -39,10 +80,22 @@ assert(pfFree);
     list_s * const psRefs = (list_s *)poolAlloc(psPool, sizeof(list_s));
     if ( NULL != psRefs )
     {
+        // ? the chunks share one slab per pool
+        *(void **)&psRefs->psSlab = slabMake(psPool, sizeof(chunk_s));
+        if ( NULL == psRefs->psSlab )
+        {
+            poolErase(psPool, psRefs);
+            return NULL;
+        }
+
         *(void **)&psRefs->psPool = psPool;
         *(void **)&psRefs->pfFree = pfFree;
-        psRefs->psHead = psRefs->psTail = psRefs->psPrev = psRefs->psCurr = psRefs->psNext = NULL;
+        psRefs->psHead = psRefs->psTail = psRefs->psPrev = psRefs->psCurr = NULL;
         psRefs->zLength = psRefs->zRecord = 0;
+        psRefs->bRevert = false;
+        psRefs->asMark = NULL;
+        psRefs->zMarkCount = psRefs->zMarkCapacity = psRefs->zMarkDrift = 0;
+        psRefs->bMarkPartial = true;
     }
 
     return psRefs;
@@ -53,14 +106,28 @@ listFree(
     void * pvRefs
 ) {
     list_s * const  psRefs = (list_s *)( pvRefs );
+    chunk_s * psPrev = NULL;
+    chunk_s * psCurr = NULL;
+    chunk_s * psTemp = NULL;
+    size_t idx = 0;
 
     if ( NULL != psRefs )
     {
-        while ( listLength(psRefs) > 0 )
+        // ? walk the chunks once instead of removing value by value
+        for ( psCurr = psRefs->psHead; NULL != psCurr; psPrev = psTemp )
         {
-            listRemove(psRefs, 0);
+            for ( idx = 0; idx < psCurr->zCount; ++idx )
+            {
+                psRefs->pfFree(psCurr->apValue[ idx ]);
+            }
+
+            psTemp = psCurr;
+            psCurr = (chunk_s *)( psCurr->zXor ^ (size_t)( psPrev ) );
+            slabErase(psRefs->psSlab, psTemp);
         }
 
+        slabFree(psRefs->psSlab);
+        poolErase(psRefs->psPool, psRefs->asMark);
         poolErase(psRefs->psPool, pvRefs);
     }
 }
@@ -70,7 +137,15 @@ listAccess(
     list_s * const psRefs, 
     const size_t zIndex
 ) {
-    return _listTryAccess(psRefs, zIndex) ? ( psRefs->psCurr->pvValue ) : ( NULL ) ;
+    size_t zPhysical = 0;
+
+    if ( zIndex >= listLength(psRefs) )
+    {
+        return NULL;
+    }
+
+    zPhysical = _listPhysical(psRefs, zIndex, false);
+    return _listTryAccess(psRefs, zPhysical) ? ( psRefs->psCurr->apValue[ zPhysical - psRefs->zRecord ] ) : ( NULL ) ;
 }
 
 list_s *
@@ -79,61 +154,112 @@ listInsert(
     const size_t zIndex, 
     void * const pvValue
 ) {
-    node_s * psTarget = NULL;
+    chunk_s * psTarget = NULL;
+    chunk_s * psNext = NULL;
+    size_t zPhysical = 0;
+    size_t zSlot = 0;
 
-    if ( NULL != psRefs )
+    if ( NULL == psRefs )
+    {
+        return psRefs;
+    }
+
+    zPhysical = _listPhysical(psRefs, zIndex, true);
+
+    if ( 0 == listLength(psRefs) )
     {
-        psTarget = (node_s *)poolAlloc(psRefs->psPool, sizeof(node_s));
-        if ( NULL != psTarget )
+        psTarget = _listChunkAfter(psRefs, NULL, NULL);
+        if ( NULL == psTarget ) // ! Error: slab is full
         {
-            psTarget->pvValue = pvValue;
+            return NULL;
+        }
 
-            if ( 0 == listLength(psRefs) )
-            {
-                psRefs->psCurr = psRefs->psHead = psRefs->psTail = psTarget;
-                psRefs->zRecord = 0;
-            }
-            else if ( zIndex == 0 ) // ? in front of the head
-            {
-                psTarget->zXor = (size_t)( psRefs->psHead );
-                psRefs->psHead->zXor ^= (size_t)( psTarget );
-                psRefs->psCurr = psRefs->psHead = psTarget;
-                psRefs->zRecord = 0;
-            }
-            else if ( zIndex >= listLength(psRefs) ) // ? append to the tail
-            {
-                psTarget->zXor = (size_t)( psRefs->psTail );
-                psRefs->psTail->zXor ^= (size_t)( psTarget );
-                psRefs->psCurr = psRefs->psTail = psTarget;
-                psRefs->zRecord = listLength(psRefs);
-            }
-            else if ( true == _listTryAccess(psRefs, zIndex) )
-            {
-                psTarget->zXor = ( (size_t)( psRefs->psPrev ) ^ (size_t)( psRefs->psCurr ) );
+        psRefs->psPrev = NULL;
+        psRefs->psCurr = psTarget;
+        psRefs->zRecord = 0;
+    }
+    else if ( zPhysical == listLength(psRefs) ) // ? append to the tail chunk
+    {
+        psRefs->psCurr = psRefs->psTail;
+        psRefs->psPrev = (chunk_s *)( psRefs->psTail->zXor );
+        psRefs->zRecord = listLength(psRefs) - psRefs->psTail->zCount;
+    }
+    else if ( true != _listTryAccess(psRefs, zPhysical) ) // ! Error: cannot find correct position
+    {
+        return NULL;
+    }
 
-                psRefs->psPrev->zXor ^= (size_t)( psRefs->psCurr );
-                psRefs->psPrev->zXor ^= (size_t)( psTarget );
+    zSlot = zPhysical - psRefs->zRecord;
+    if ( 0 == zSlot && NULL != psRefs->psPrev && LIST_CHUNK_SLOTS > psRefs->psPrev->zCount ) // ? on a boundary, fill the previous chunk first
+    {
+        psTarget = psRefs->psPrev;
+        psRefs->psPrev = (chunk_s *)( psTarget->zXor ^ (size_t)( psRefs->psCurr ) );
+        psRefs->psCurr = psTarget;
+        psRefs->zRecord -= psTarget->zCount;
+        zSlot = psTarget->zCount;
+    }
 
-                psRefs->psCurr->zXor ^= (size_t)( psRefs->psPrev );
-                psRefs->psCurr->zXor ^= (size_t)( psTarget );
+    if ( LIST_CHUNK_SLOTS == psRefs->psCurr->zCount )
+    {
+        psNext = (chunk_s *)( psRefs->psCurr->zXor ^ (size_t)( psRefs->psPrev ) );
 
-                psRefs->psCurr = psTarget;
-                psRefs->zRecord = zIndex;
+        if ( 0 == zSlot && NULL == psRefs->psPrev ) // ? in front of the head, start a new chunk
+        {
+            psTarget = _listChunkAfter(psRefs, NULL, psRefs->psCurr);
+            if ( NULL == psTarget )
+            {
+                return NULL;
             }
-            else // ! Error: cannot find correct position
+
+            _listIndexRelink(psRefs, 0, NULL, psTarget, NULL);
+
+            psRefs->psPrev = NULL;
+            psRefs->psCurr = psTarget;
+        }
+        else if ( LIST_CHUNK_SLOTS == zSlot && NULL == psNext ) // ? behind the tail, start a new chunk
+        {
+            psTarget = _listChunkAfter(psRefs, psRefs->psCurr, NULL);
+            if ( NULL == psTarget )
             {
-                poolErase(psRefs->psPool, psTarget);
                 return NULL;
             }
 
-            psRefs->zLength++;
+            psRefs->psPrev = psRefs->psCurr;
+            psRefs->psCurr = psTarget;
+            psRefs->zRecord += LIST_CHUNK_SLOTS;
+            psRefs->bMarkPartial = true;
+            zSlot = 0;
         }
-        else  // ! Error: calloc failed
+        else // ? split, the upper half moves to a new chunk behind this one
         {
-            return NULL;
+            psTarget = _listChunkAfter(psRefs, psRefs->psCurr, psNext);
+            if ( NULL == psTarget )
+            {
+                return NULL;
+            }
+            _listIndexRelink(psRefs, psRefs->zRecord + 1, psRefs->psCurr, psTarget, NULL);
+
+            memcpy(psTarget->apValue, psRefs->psCurr->apValue + LIST_CHUNK_SLOTS / 2, ( LIST_CHUNK_SLOTS - LIST_CHUNK_SLOTS / 2 ) * sizeof(void *));
+            psTarget->zCount = LIST_CHUNK_SLOTS - LIST_CHUNK_SLOTS / 2;
+            psRefs->psCurr->zCount = LIST_CHUNK_SLOTS / 2;
+
+            if ( zSlot > LIST_CHUNK_SLOTS / 2 )
+            {
+                psRefs->psPrev = psRefs->psCurr;
+                psRefs->psCurr = psTarget;
+                psRefs->zRecord += LIST_CHUNK_SLOTS / 2;
+                zSlot -= LIST_CHUNK_SLOTS / 2;
+            }
         }
     }
 
+    psTarget = psRefs->psCurr;
+    memmove(psTarget->apValue + zSlot + 1, psTarget->apValue + zSlot, ( psTarget->zCount - zSlot ) * sizeof(void *));
+    psTarget->apValue[ zSlot ] = pvValue;
+    psTarget->zCount++;
+    psRefs->zLength++;
+    _listIndexShift(psRefs, psRefs->zRecord, true);
+
     return psRefs;
 }
 
@@ -143,16 +269,22 @@ listChange(
     const size_t zIndex, 
     void * const pvValue
 ) {
-    list_s * psRet = psRefs;
+    size_t zPhysical = 0;
+
+    if ( zIndex >= listLength(psRefs) )
+    {
+        return listInsert(psRefs, zIndex, pvValue);
+    }
 
-    if ( true != _listTryAccess(psRefs, zIndex) )
+    zPhysical = _listPhysical(psRefs, zIndex, false);
+    if ( true != _listTryAccess(psRefs, zPhysical) )
     {
         return listInsert(psRefs, zIndex, pvValue);
     }
     else
     {
-        psRefs->pfFree(psRefs->psCurr->pvValue);
-        psRefs->psCurr->pvValue = pvValue;
+        psRefs->pfFree(psRefs->psCurr->apValue[ zPhysical - psRefs->zRecord ]);
+        psRefs->psCurr->apValue[ zPhysical - psRefs->zRecord ] = pvValue;
     }
 
     return psRefs;
@@ -163,69 +295,334 @@ listRemove(
     list_s * const psRefs, 
     const size_t zIndex
 ) {
-    node_s * psTarget = NULL;
+    chunk_s * psTarget = NULL;
+    chunk_s * psNext = NULL;
+    size_t zPhysical = 0;
+    size_t zSlot = 0;
 
-    if ( true == _listTryAccess(psRefs, zIndex) )
+    if ( zIndex >= listLength(psRefs) )
+    {
+        return psRefs;
+    }
+
+    zPhysical = _listPhysical(psRefs, zIndex, false);
+    if ( true == _listTryAccess(psRefs, zPhysical) )
     {
         psTarget = psRefs->psCurr;
+        zSlot = zPhysical - psRefs->zRecord;
 
-        if ( 1 == listLength(psRefs) )
+        psRefs->pfFree(psTarget->apValue[ zSlot ]);
+        memmove(psTarget->apValue + zSlot, psTarget->apValue + zSlot + 1, ( psTarget->zCount - zSlot - 1 ) * sizeof(void *));
+        psTarget->zCount--;
+        psRefs->zLength--;
+
+        psNext = (chunk_s *)( psTarget->zXor ^ (size_t)( psRefs->psPrev ) );
+        if ( 0 == psTarget->zCount )
         {
-            psRefs->psCurr = psRefs->psHead = psRefs->psTail = NULL;
-            psRefs->zRecord = 0;
+            _listIndexRelink(psRefs, psRefs->zRecord, psTarget, psRefs->psPrev, psTarget);
+            _listIndexShift(psRefs, psRefs->zRecord, false);
+            _listChunkDrop(psRefs, psRefs->psPrev, psTarget);
         }
-        else if ( zIndex == 0 )
+        else if ( NULL != psNext && psTarget->zCount < LIST_CHUNK_SLOTS / 2 && psTarget->zCount + psNext->zCount <= LIST_CHUNK_SLOTS )
         {
-            psRefs->psNext->zXor ^= (size_t)( psRefs->psCurr );
-            psRefs->psHead = psRefs->psCurr = psRefs->psNext;
-            psRefs->psNext = (node_s *)( psRefs->psHead->zXor );
-            psRefs->zRecord = 0;
+            // ? a chunk under half full takes in its next neighbour when both fit in one
+            _listIndexRelink(psRefs, psRefs->zRecord + 1, psNext, psTarget, psNext);
+            _listIndexShift(psRefs, psRefs->zRecord, false);
+            memcpy(psTarget->apValue + psTarget->zCount, psNext->apValue, psNext->zCount * sizeof(void *));
+            psTarget->zCount += psNext->zCount;
+            _listChunkDrop(psRefs, psTarget, psNext);
+        }
+        else
+        {
+            _listIndexShift(psRefs, psRefs->zRecord, false);
+        }
+    }
+
+    return psRefs;
+}
+
+list_s *
+listAppendBatch(
+    list_s * const psRefs,
+    void * const * const apValue,
+    const size_t zCount
+) {
+    chunk_s * psTarget = NULL;
+    size_t zDone = 0;
+    size_t zTake = 0;
+    size_t idx = 0;
+
+    if ( NULL == psRefs )
+    {
+        return psRefs;
+    }
+
+    // ? fills the last chunk, then whole chunks, a reverted list grows in front of its head with the values backwards
+    while ( zDone < zCount )
+    {
+        psTarget = ( psRefs->bRevert ) ? ( psRefs->psHead ) : ( psRefs->psTail ) ;
+        if ( NULL == psTarget || LIST_CHUNK_SLOTS == psTarget->zCount )
+        {
+            psTarget = ( psRefs->bRevert ) ?
+                _listChunkAfter(psRefs, NULL, psRefs->psHead) :
+                _listChunkAfter(psRefs, psRefs->psTail, NULL) ;
+            if ( NULL == psTarget ) // ! Error: slab is full
+            {
+                break;
+            }
         }
-        else if ( zIndex == listLength(psRefs) - 1 )
+
+        zTake = LIST_CHUNK_SLOTS - psTarget->zCount;
+        zTake = ( zTake < zCount - zDone ) ? ( zTake ) : ( zCount - zDone ) ;
+        if ( psRefs->bRevert )
         {
-            psRefs->psPrev->zXor ^= (size_t)( psRefs->psCurr );
-            psRefs->psTail = psRefs->psCurr = psRefs->psPrev;
-            psRefs->psPrev = (node_s *)( psRefs->psTail->zXor );
-            psRefs->zRecord = zIndex - 1;
+            memmove(psTarget->apValue + zTake, psTarget->apValue, psTarget->zCount * sizeof(void *));
+            for ( idx = 0; idx < zTake; ++idx )
+            {
+                psTarget->apValue[ zTake - 1 - idx ] = apValue[ zDone + idx ];
+            }
         }
         else
         {
-            psRefs->psPrev->zXor ^= (size_t)( psRefs->psCurr );
-            psRefs->psPrev->zXor ^= (size_t)( psRefs->psNext );
+            memcpy(psTarget->apValue + psTarget->zCount, apValue + zDone, zTake * sizeof(void *));
+        }
+
+        psTarget->zCount += zTake;
+        psRefs->zLength += zTake;
+        zDone += zTake;
+    }
+
+    // ? growing at the head moves every physical index, growing at the tail only leaves chunks behind the last mark
+    if ( psRefs->bRevert )
+    {
+        _listReindex(psRefs);
+    }
+    else
+    {
+        psRefs->bMarkPartial = true;
+        if ( NULL == psRefs->psCurr )
+        {
+            _listReindex(psRefs);
+        }
+    }
+
+    return ( zDone == zCount ) ? ( psRefs ) : ( NULL ) ;
+}
+
+list_s *
+listConcat(
+    list_s * const psRefs,
+    list_s * const psOther
+) {
+    chunk_s * psTarget = NULL;
+    size_t zBefore = 0;
+    size_t zMoved = 0;
+    bool bDone = false;
+
+    if ( NULL == psRefs || NULL == psOther || psRefs == psOther )
+    {
+        return NULL;
+    }
+
+    if ( 0 == listLength(psOther) )
+    {
+        return psRefs;
+    }
+
+    if ( 0 == listLength(psRefs) ) // ? an empty list takes the other's direction for free
+    {
+        psRefs->bRevert = psOther->bRevert;
+    }
+
+    if ( psRefs->psSlab != psOther->psSlab ) // ? chunks of another pool are copied over one by one
+    {
+        if ( psOther->bRevert )
+        {
+            _listFlip(psOther);
+        }
 
-            psRefs->psNext->zXor ^= (size_t)( psRefs->psCurr );
-            psRefs->psNext->zXor ^= (size_t)( psRefs->psPrev );
+        while ( NULL != psOther->psHead )
+        {
+            psTarget = psOther->psHead;
+            zBefore = listLength(psRefs);
+            bDone = ( NULL != listAppendBatch(psRefs, psTarget->apValue, psTarget->zCount) );
 
-            psRefs->psCurr = psRefs->psNext;
-            psRefs->psNext = (node_s *)( psRefs->psCurr->zXor ^ (size_t)( psRefs->psPrev ) );
+            // ? whatever got over leaves psOther, so no value ends up in both lists
+            zMoved = listLength(psRefs) - zBefore;
+            memmove(psTarget->apValue, psTarget->apValue + zMoved, ( psTarget->zCount - zMoved ) * sizeof(void *));
+            psTarget->zCount -= zMoved;
+            psOther->zLength -= zMoved;
+            if ( 0 == psTarget->zCount )
+            {
+                _listChunkDrop(psOther, NULL, psTarget);
+            }
 
-            psRefs->zRecord = zIndex;
+            if ( !bDone )
+            {
+                _listReindex(psOther);
+                return NULL;
+            }
         }
 
-        psRefs->pfFree(psTarget->pvValue);
-        poolErase(psRefs->psPool, psTarget);
+        _listForget(psOther);
+        return psRefs;
+    }
 
-        psRefs->zLength--;
+    // ? relinking is O(1) when both run the same way, otherwise psOther is turned over first
+    if ( psRefs->bRevert != psOther->bRevert )
+    {
+        _listFlip(psOther);
     }
 
+    if ( 0 == listLength(psRefs) )
+    {
+        psRefs->psHead = psOther->psHead;
+        psRefs->psTail = psOther->psTail;
+        _listReindex(psRefs);
+    }
+    else if ( !psRefs->bRevert )
+    {
+        psRefs->psTail->zXor ^= (size_t)( psOther->psHead );
+        psOther->psHead->zXor ^= (size_t)( psRefs->psTail );
+        psRefs->psTail = psOther->psTail;
+        psRefs->bMarkPartial = true;
+    }
+    else
+    {
+        psOther->psTail->zXor ^= (size_t)( psRefs->psHead );
+        psRefs->psHead->zXor ^= (size_t)( psOther->psTail );
+        psRefs->psHead = psOther->psHead;
+        _listReindex(psRefs);
+    }
+
+    psRefs->zLength += listLength(psOther);
+    _listForget(psOther);
+
     return psRefs;
 }
 
 list_s *
-listRevert(
-    list_s * const psRefs
+listSplice(
+    list_s * const psRefs,
+    const size_t zIndex,
+    list_s * const psOther
 ) {
-    if ( listLength(psRefs) > 1 )
+    list_s * psRest = NULL;
+    list_s * psRet = NULL;
+
+    if ( NULL == psRefs || NULL == psOther || psRefs == psOther )
     {
-        psRefs->psCurr = psRefs->psTail;
-        psRefs->psTail = psRefs->psHead;
-        psRefs->psHead = psRefs->psCurr;
+        return NULL;
+    }
 
-        psRefs->psPrev = NULL;
-        psRefs->psNext = (node_s *)( psRefs->psHead->zXor );
+    if ( zIndex >= listLength(psRefs) || 0 == listLength(psOther) )
+    {
+        return listConcat(psRefs, psOther);
+    }
+
+    // ? cut, append, glue back, the two lists of one pool only cost the walk to zIndex
+    psRest = listSplit(psRefs, zIndex);
+    if ( NULL == psRest )
+    {
+        return NULL;
+    }
+
+    psRet = listConcat(psRefs, psOther);
+    listConcat(psRefs, psRest);
+    listFree(psRest);
+
+    return psRet;
+}
+
+list_s *
+listSplit(
+    list_s * const psRefs,
+    const size_t zIndex
+) {
+    list_s * psSplit = NULL;
+    chunk_s * psLeft = NULL;
+    chunk_s * psRight = NULL;
+    size_t zPhysical = 0;
+
+    if ( NULL == psRefs )
+    {
+        return NULL;
+    }
+
+    psSplit = listMake(psRefs->psPool, psRefs->pfFree);
+    if ( NULL == psSplit )
+    {
+        return NULL;
+    }
+    psSplit->bRevert = psRefs->bRevert;
+
+    if ( zIndex >= listLength(psRefs) )
+    {
+        return psSplit;
+    }
+
+    // ? every value moves, the chunks change hands as they are
+    if ( 0 == zIndex )
+    {
+        psSplit->psHead = psRefs->psHead;
+        psSplit->psTail = psRefs->psTail;
+        psSplit->zLength = listLength(psRefs);
+        _listReindex(psSplit);
+        _listForget(psRefs);
+        return psSplit;
+    }
+
+    // ? a reverted list hands over its physical front
+    zPhysical = ( psRefs->bRevert ) ? ( listLength(psRefs) - zIndex ) : ( zIndex ) ;
+    if ( !_listBoundary(psRefs, zPhysical, &psLeft, &psRight) )
+    {
+        listFree(psSplit);
+        return NULL;
+    }
+
+    psLeft->zXor ^= (size_t)( psRight );
+    psRight->zXor ^= (size_t)( psLeft );
+
+    if ( !psRefs->bRevert )
+    {
+        psSplit->psHead = psRight;
+        psSplit->psTail = psRefs->psTail;
+        psSplit->zLength = listLength(psRefs) - zPhysical;
+        psRefs->psTail = psLeft;
+        psRefs->zLength = zPhysical;
 
+        // ? the marks in front of the cut stay good
+        while ( 0 < psRefs->zMarkCount && psRefs->asMark[ psRefs->zMarkCount - 1 ].zRecord >= zPhysical )
+        {
+            psRefs->zMarkCount--;
+        }
+        psRefs->bMarkPartial = true;
+        psRefs->psPrev = NULL;
+        psRefs->psCurr = psRefs->psHead;
         psRefs->zRecord = 0;
     }
+    else
+    {
+        psSplit->psHead = psRefs->psHead;
+        psSplit->psTail = psLeft;
+        psSplit->zLength = zPhysical;
+        psRefs->psHead = psRight;
+        psRefs->zLength = listLength(psRefs) - zPhysical;
+        _listReindex(psRefs);
+    }
+
+    _listReindex(psSplit);
+    return psSplit;
+}
+
+list_s *
+listRevert(
+    list_s * const psRefs
+) {
+    if ( NULL != psRefs )
+    {
+        psRefs->bRevert = !psRefs->bRevert;
+    }
 
     return psRefs;
 }
@@ -244,76 +641,703 @@ listQuickSort(
 ) {
 assert( NULL != pfCompare );
 
+    void ** apValue = NULL;
+    unsigned int uDepth = 0;
+
+    if ( listLength(psRefs) > 1 )
+    {
+        // ? sorting a contiguous copy of the values beats walking the chunks, the chunks keep their place
+        apValue = _listGather(psRefs);
+        if ( NULL == apValue )
+        {
+            return NULL;
+        }
+
+        for ( uDepth = 0; ( (size_t)1 << uDepth ) < listLength(psRefs); ++uDepth ) { }
+        _listQuickSort(apValue, listLength(psRefs), 2 * uDepth, pfCompare);
+
+        _listScatter(psRefs, apValue);
+        free(apValue);
+    }
+
+    return psRefs;
+}
+
+list_s *
+listStableSort(
+    list_s * const psRefs,
+    int (* const pfCompare)(void *, void *)
+) {
+assert( NULL != pfCompare );
+
+    void ** apValue = NULL;
+    void ** apSpare = NULL;
+
     if ( listLength(psRefs) > 1 )
     {
-        _listQuickSort(psRefs->psHead, psRefs->psTail, pfCompare);
+        apValue = _listGather(psRefs);
+        apSpare = (void **)malloc(listLength(psRefs) * sizeof(void *));
+        if ( NULL == apValue || NULL == apSpare )
+        {
+            free(apValue);
+            free(apSpare);
+            return NULL;
+        }
+
+        _listScatter(psRefs, _listMergeSort(apValue, apSpare, listLength(psRefs), pfCompare));
+        free(apSpare);
+        free(apValue);
     }
 
     return psRefs;
 }
 
 /* private */
+static
+size_t
+_listPhysical(
+    list_s const * const psRefs,
+    const size_t zIndex,
+    const bool bInsert
+) {
+    const size_t zIndexMax = ( bInsert ) ? ( listLength(psRefs) ) : ( listLength(psRefs) - 1 ) ;
+    const size_t zClamp = ( zIndex > zIndexMax ) ? ( zIndexMax ) : ( zIndex ) ;
+
+    // ? a value inserted in front of reverted index i lands in front of physical index n - i
+    return ( psRefs->bRevert ) ? ( zIndexMax - zClamp ) : ( zClamp ) ;
+}
+
 static 
 bool 
 _listTryAccess(
     list_s * const psRefs, 
     const size_t zIndex
 ) {
-    node_s * psTemp = NULL;
+    chunk_s * psTemp = NULL;
 
-    if ( NULL == psRefs )
+    if ( NULL == psRefs || zIndex >= listLength(psRefs) )
     {
         return false;
     }
 
-    if ( zIndex >= listLength(psRefs) )
+    // ? far jumps go through the skip index, otherwise restart from the closer end when the cursor is farther away
+    if ( ( zIndex + LIST_INDEX_REACH >= psRefs->zRecord && zIndex < psRefs->zRecord + LIST_INDEX_REACH ) || !_listIndexSeek(psRefs, zIndex) )
+    {
+        if ( zIndex < psRefs->zRecord && zIndex < psRefs->zRecord - zIndex )
+        {
+            psRefs->psCurr = psRefs->psHead;
+            psRefs->psPrev = NULL;
+            psRefs->zRecord = 0;
+        }
+        else if ( zIndex >= psRefs->zRecord + psRefs->psCurr->zCount && listLength(psRefs) - zIndex < zIndex - psRefs->zRecord )
+        {
+            psRefs->psCurr = psRefs->psTail;
+            psRefs->psPrev = (chunk_s *)( psRefs->psTail->zXor );
+            psRefs->zRecord = listLength(psRefs) - psRefs->psTail->zCount;
+        }
+    }
+
+    while ( zIndex >= psRefs->zRecord + psRefs->psCurr->zCount )
+    {
+        psTemp = psRefs->psCurr;
+        psRefs->zRecord += psRefs->psCurr->zCount;
+        psRefs->psCurr = (chunk_s *)( psRefs->psCurr->zXor ^ (size_t)( psRefs->psPrev ) );
+        psRefs->psPrev = psTemp;
+    }
+    while ( zIndex < psRefs->zRecord )
+    {
+        psTemp = psRefs->psPrev;
+        psRefs->psPrev = (chunk_s *)( psRefs->psPrev->zXor ^ (size_t)( psRefs->psCurr ) );
+        psRefs->psCurr = psTemp;
+        psRefs->zRecord -= psRefs->psCurr->zCount;
+    }
+
+    return true;
+}
+
+static
+bool
+_listIndexSeek(
+    list_s * const psRefs,
+    const size_t zIndex
+) {
+    size_t zLow = 0;
+    size_t zHigh = 0;
+    size_t zMiddle = 0;
+
+    // ? the marks only have to reach the target, the walk goes on from the last one
+    if ( psRefs->bMarkPartial && ( 0 == psRefs->zMarkCount || zIndex >= psRefs->asMark[ psRefs->zMarkCount - 1 ].zRecord ) && !_listIndexBuild(psRefs, zIndex) )
     {
         return false;
     }
 
-    if ( zIndex == 0 )
+    // ? the last mark at or before the target, or the first one when the head lost its mark, the walk goes back from there
+    zLow = 0;
+    zHigh = psRefs->zMarkCount;
+    while ( zHigh - zLow > 1 )
     {
-        psRefs->psCurr = psRefs->psHead;
-        psRefs->psPrev = NULL;
-        psRefs->psNext = (node_s *)( psRefs->psCurr->zXor );
-        psRefs->zRecord = zIndex;
+        zMiddle = zLow + ( zHigh - zLow ) / 2;
+        if ( psRefs->asMark[ zMiddle ].zRecord <= zIndex )
+        {
+            zLow = zMiddle;
+        }
+        else
+        {
+            zHigh = zMiddle;
+        }
+    }
+
+    psRefs->psPrev = psRefs->asMark[ zLow ].psPrev;
+    psRefs->psCurr = psRefs->asMark[ zLow ].psCurr;
+    psRefs->zRecord = psRefs->asMark[ zLow ].zRecord;
+
+    return true;
+}
+
+static
+bool
+_listIndexBuild(
+    list_s * const psRefs,
+    const size_t zIndex
+) {
+    mark_s * asMark = NULL;
+    chunk_s * psPrev = NULL;
+    chunk_s * psCurr = psRefs->psHead;
+    chunk_s * psTemp = NULL;
+    size_t zRecord = 0;
+    size_t zChunk = 0;
+
+    // ? picks the walk up at the last mark and stops at the first mark past zIndex, so it walks no farther than the access would
+    if ( 0 != psRefs->zMarkCount )
+    {
+        psRefs->zMarkCount--;
+        psPrev = psRefs->asMark[ psRefs->zMarkCount ].psPrev;
+        psCurr = psRefs->asMark[ psRefs->zMarkCount ].psCurr;
+        zRecord = psRefs->asMark[ psRefs->zMarkCount ].zRecord;
     }
-    else if ( zIndex == listLength(psRefs) - 1 )
+
+    for ( ; NULL != psCurr; ++zChunk, psPrev = psTemp )
     {
-        psRefs->psCurr = psRefs->psTail;
-        psRefs->psPrev = (node_s *)( psRefs->psCurr->zXor );
-        psRefs->psNext = NULL;
-        psRefs->zRecord = zIndex;
+        if ( 0 == zChunk % LIST_INDEX_STRIDE )
+        {
+            if ( psRefs->zMarkCount == psRefs->zMarkCapacity )
+            {
+                asMark = ( NULL == psRefs->asMark ) ?
+                    (mark_s *)poolAlloc(psRefs->psPool, 16 * sizeof(mark_s)) :
+                    (mark_s *)poolResize(psRefs->psPool, psRefs->asMark, 2 * psRefs->zMarkCapacity * sizeof(mark_s)) ;
+                if ( NULL == asMark )
+                {
+                    return false;
+                }
+
+                psRefs->zMarkCapacity = ( NULL == psRefs->asMark ) ? ( 16 ) : ( 2 * psRefs->zMarkCapacity ) ;
+                psRefs->asMark = asMark;
+            }
+
+            psRefs->asMark[ psRefs->zMarkCount ].psPrev = psPrev;
+            psRefs->asMark[ psRefs->zMarkCount ].psCurr = psCurr;
+            psRefs->asMark[ psRefs->zMarkCount ].zRecord = zRecord;
+            psRefs->zMarkCount++;
+
+            if ( zRecord > zIndex )
+            {
+                return true;
+            }
+        }
+
+        zRecord += psCurr->zCount;
+        psTemp = psCurr;
+        psCurr = (chunk_s *)( psCurr->zXor ^ (size_t)( psPrev ) );
+    }
+
+    psRefs->bMarkPartial = false;
+    return true;
+}
+
+static
+void
+_listIndexShift(
+    list_s * const psRefs,
+    const size_t zRecord,
+    const bool bGrow
+) {
+    size_t idx = psRefs->zMarkCount;
+
+    // ? a value came into or left the chunk at zRecord, the chunks behind it keep their links and move by one
+    while ( 0 < idx && psRefs->asMark[ idx - 1 ].zRecord > zRecord )
+    {
+        --idx;
+        psRefs->asMark[ idx ].zRecord = ( bGrow ) ? ( psRefs->asMark[ idx ].zRecord + 1 ) : ( psRefs->asMark[ idx ].zRecord - 1 ) ;
+    }
+}
+
+static
+void
+_listIndexRelink(
+    list_s * const psRefs,
+    const size_t zRecord,
+    chunk_s * const psFrom,
+    chunk_s * const psTo,
+    chunk_s * const psGone
+) {
+    size_t idx = psRefs->zMarkCount;
+
+    // ? from the end down to zRecord, a mark on psGone leaves and a mark behind psFrom comes behind psTo now
+    while ( 0 < idx && psRefs->asMark[ idx - 1 ].zRecord >= zRecord )
+    {
+        --idx;
+        if ( psGone == psRefs->asMark[ idx ].psCurr )
+        {
+            memmove(psRefs->asMark + idx, psRefs->asMark + idx + 1, ( psRefs->zMarkCount - idx - 1 ) * sizeof(mark_s));
+            psRefs->zMarkCount--;
+        }
+        else if ( psFrom == psRefs->asMark[ idx ].psPrev && NULL == psFrom ) // ? a new head takes the head mark over, so index 0 stays marked
+        {
+            psRefs->asMark[ idx ].psCurr = psTo;
+        }
+        else if ( psFrom == psRefs->asMark[ idx ].psPrev )
+        {
+            psRefs->asMark[ idx ].psPrev = psTo;
+        }
+    }
+
+    // ? every new chunk widens a gap between two marks, once the gaps have doubled on average the index starts over
+    if ( ++psRefs->zMarkDrift > psRefs->zMarkCount )
+    {
+        psRefs->zMarkCount = 0;
+        psRefs->zMarkDrift = 0;
+        psRefs->bMarkPartial = true;
+    }
+}
+
+static
+chunk_s *
+_listChunkAfter(
+    list_s * const psRefs,
+    chunk_s * const psPrev,
+    chunk_s * const psNext
+) {
+    chunk_s * const psTarget = (chunk_s *)slabAlloc(psRefs->psSlab);
+
+    if ( NULL == psTarget )
+    {
+        return NULL;
+    }
+
+    // ? links an empty chunk between two neighbours, either may be NULL at an end
+    psTarget->zCount = 0;
+    psTarget->zXor = (size_t)( psPrev ) ^ (size_t)( psNext );
+
+    if ( NULL == psPrev )
+    {
+        psRefs->psHead = psTarget;
+    }
+    else
+    {
+        psPrev->zXor ^= (size_t)( psNext ) ^ (size_t)( psTarget );
+    }
+
+    if ( NULL == psNext )
+    {
+        psRefs->psTail = psTarget;
+    }
+    else
+    {
+        psNext->zXor ^= (size_t)( psPrev ) ^ (size_t)( psTarget );
+    }
+
+    return psTarget;
+}
+
+static
+void
+_listChunkDrop(
+    list_s * const psRefs,
+    chunk_s * const psPrev,
+    chunk_s * const psTarget
+) {
+    chunk_s * const psNext = (chunk_s *)( psTarget->zXor ^ (size_t)( psPrev ) );
+
+    if ( NULL == psPrev )
+    {
+        psRefs->psHead = psNext;
+    }
+    else
+    {
+        psPrev->zXor ^= (size_t)( psTarget ) ^ (size_t)( psNext );
+    }
+
+    if ( NULL == psNext )
+    {
+        psRefs->psTail = psPrev;
     }
     else
     {
-        while ( psRefs->zRecord < zIndex )
+        psNext->zXor ^= (size_t)( psTarget ) ^ (size_t)( psPrev );
+    }
+
+    slabErase(psRefs->psSlab, psTarget);
+
+    // ? the cursor moves to the next chunk, or back to the previous one at the tail
+    if ( psRefs->psCurr == psTarget )
+    {
+        if ( NULL != psNext )
         {
-            psTemp = psRefs->psCurr;
-            psRefs->psPrev = psRefs->psCurr;
-            psRefs->psCurr = psRefs->psNext;
-            psRefs->psNext = (node_s *)( psRefs->psNext->zXor ^ (size_t)( psTemp ) );
-            psRefs->zRecord++;
+            psRefs->psCurr = psNext;
         }
-        while ( psRefs->zRecord > zIndex )
+        else if ( NULL != psPrev )
         {
-            psTemp = psRefs->psCurr;
-            psRefs->psNext = psRefs->psCurr;
-            psRefs->psCurr = psRefs->psPrev;
-            psRefs->psPrev = (node_s *)( psRefs->psPrev->zXor ^ (size_t)( psTemp ) );
-            psRefs->zRecord--;
+            psRefs->psCurr = psPrev;
+            psRefs->psPrev = (chunk_s *)( psPrev->zXor );
+            psRefs->zRecord -= psPrev->zCount;
         }
+        else
+        {
+            psRefs->psCurr = psRefs->psPrev = NULL;
+            psRefs->zRecord = 0;
+        }
+    }
+}
+
+static
+bool
+_listBoundary(
+    list_s * const psRefs,
+    const size_t zIndex,
+    chunk_s ** const ppsLeft,
+    chunk_s ** const ppsRight
+) {
+    chunk_s * psTarget = NULL;
+    size_t zSlot = 0;
+
+    if ( !_listTryAccess(psRefs, zIndex) )
+    {
+        return false;
+    }
+
+    // ? a chunk holding both sides of zIndex gives its upper part to a new chunk behind it
+    zSlot = zIndex - psRefs->zRecord;
+    if ( 0 == zSlot )
+    {
+        *ppsLeft = psRefs->psPrev;
+        *ppsRight = psRefs->psCurr;
+        return true;
     }
 
+    psTarget = _listChunkAfter(psRefs, psRefs->psCurr, (chunk_s *)( psRefs->psCurr->zXor ^ (size_t)( psRefs->psPrev ) ));
+    if ( NULL == psTarget ) // ! Error: slab is full
+    {
+        return false;
+    }
+    _listIndexRelink(psRefs, psRefs->zRecord + 1, psRefs->psCurr, psTarget, NULL);
+
+    memcpy(psTarget->apValue, psRefs->psCurr->apValue + zSlot, ( psRefs->psCurr->zCount - zSlot ) * sizeof(void *));
+    psTarget->zCount = psRefs->psCurr->zCount - zSlot;
+    psRefs->psCurr->zCount = zSlot;
+
+    *ppsLeft = psRefs->psCurr;
+    *ppsRight = psTarget;
     return true;
 }
 
+static
+void
+_listFlip(
+    list_s * const psRefs
+) {
+    chunk_s * psPrev = NULL;
+    chunk_s * psCurr = psRefs->psHead;
+    chunk_s * psTemp = NULL;
+    void * pvTemp = NULL;
+    size_t idx = 0;
+
+    // ? turns the physical order over and bRevert with it, so the index order stays, the xor links read the same both ways
+    for ( ; NULL != psCurr; psPrev = psTemp )
+    {
+        for ( idx = 0; idx < psCurr->zCount / 2; ++idx )
+        {
+            pvTemp = psCurr->apValue[ idx ];
+            psCurr->apValue[ idx ] = psCurr->apValue[ psCurr->zCount - 1 - idx ];
+            psCurr->apValue[ psCurr->zCount - 1 - idx ] = pvTemp;
+        }
+
+        psTemp = psCurr;
+        psCurr = (chunk_s *)( psCurr->zXor ^ (size_t)( psPrev ) );
+    }
+
+    psTemp = psRefs->psHead;
+    psRefs->psHead = psRefs->psTail;
+    psRefs->psTail = psTemp;
+    psRefs->bRevert = !psRefs->bRevert;
+    _listReindex(psRefs);
+}
+
+static
+void
+_listReindex(
+    list_s * const psRefs
+) {
+    // ? the physical indexes moved, the cursor goes back to the head and the skip index starts over
+    psRefs->psPrev = NULL;
+    psRefs->psCurr = psRefs->psHead;
+    psRefs->zRecord = 0;
+    psRefs->zMarkCount = psRefs->zMarkDrift = 0;
+    psRefs->bMarkPartial = true;
+}
+
+static
+void
+_listForget(
+    list_s * const psRefs
+) {
+    // ? the chunks went to another list, they are not erased here
+    psRefs->psHead = psRefs->psTail = NULL;
+    psRefs->zLength = 0;
+    _listReindex(psRefs);
+}
+
+static
+void **
+_listGather(
+    list_s * const psRefs
+) {
+    void ** const apValue = (void **)malloc(listLength(psRefs) * sizeof(void *));
+    chunk_s * psPrev = NULL;
+    chunk_s * psCurr = psRefs->psHead;
+    chunk_s * psTemp = NULL;
+    size_t zDone = 0;
+    size_t idx = 0;
+
+    if ( NULL == apValue )
+    {
+        return NULL;
+    }
+
+    // ? the array follows the index order, so a reverted list is read backwards
+    for ( ; NULL != psCurr; psPrev = psTemp )
+    {
+        for ( idx = 0; idx < psCurr->zCount; ++idx, ++zDone )
+        {
+            apValue[ ( psRefs->bRevert ) ? ( listLength(psRefs) - 1 - zDone ) : ( zDone ) ] = psCurr->apValue[ idx ];
+        }
+
+        psTemp = psCurr;
+        psCurr = (chunk_s *)( psCurr->zXor ^ (size_t)( psPrev ) );
+    }
+
+    return apValue;
+}
+
+static
+void
+_listScatter(
+    list_s * const psRefs,
+    void ** const apValue
+) {
+    chunk_s * psPrev = NULL;
+    chunk_s * psCurr = psRefs->psHead;
+    chunk_s * psTemp = NULL;
+    size_t zDone = 0;
+    size_t idx = 0;
+
+    for ( ; NULL != psCurr; psPrev = psTemp )
+    {
+        for ( idx = 0; idx < psCurr->zCount; ++idx, ++zDone )
+        {
+            psCurr->apValue[ idx ] = apValue[ ( psRefs->bRevert ) ? ( listLength(psRefs) - 1 - zDone ) : ( zDone ) ];
+        }
+
+        psTemp = psCurr;
+        psCurr = (chunk_s *)( psCurr->zXor ^ (size_t)( psPrev ) );
+    }
+}
+
 static 
 void 
 _listQuickSort(
-    node_s * const psHead, 
-    node_s * const psTail, 
+    void ** const apValue,
+    const size_t zCount,
+    unsigned int uDepth,
+    int (* const pfCompare)(void *, void *)
+) {
+    void ** pLeft = NULL;
+    void ** pRight = NULL;
+    void * pvPivot = NULL;
+    void * pvTemp = NULL;
+    size_t zCurr = zCount;
+    void ** apCurr = apValue;
+
+    // ? introsort, the larger side loops and the smaller recurses, heapsort takes over when the depth runs out
+    while ( zCurr > 16 )
+    {
+        if ( 0 == uDepth-- )
+        {
+            _listHeapSort(apCurr, zCurr, pfCompare);
+            return;
+        }
+
+        // ? median of three to the front, it is then the pivot
+        if ( pfCompare(apCurr[ zCurr / 2 ], apCurr[ 0 ]) < 0 ) { pvTemp = apCurr[ zCurr / 2 ]; apCurr[ zCurr / 2 ] = apCurr[ 0 ]; apCurr[ 0 ] = pvTemp; }
+        if ( pfCompare(apCurr[ zCurr - 1 ], apCurr[ zCurr / 2 ]) < 0 ) { pvTemp = apCurr[ zCurr - 1 ]; apCurr[ zCurr - 1 ] = apCurr[ zCurr / 2 ]; apCurr[ zCurr / 2 ] = pvTemp; }
+        if ( pfCompare(apCurr[ zCurr / 2 ], apCurr[ 0 ]) < 0 ) { pvTemp = apCurr[ zCurr / 2 ]; apCurr[ zCurr / 2 ] = apCurr[ 0 ]; apCurr[ 0 ] = pvTemp; }
+        pvPivot = apCurr[ zCurr / 2 ];
+        apCurr[ zCurr / 2 ] = apCurr[ 0 ];
+        apCurr[ 0 ] = pvPivot;
+
+        // ? hoare partition, equal keys stop both scans so runs of duplicates still split in half
+        pLeft = apCurr;
+        pRight = apCurr + zCurr;
+        while ( true )
+        {
+            while ( pfCompare(*++pLeft, pvPivot) < 0 ) { } /* the last of the three stops it */
+            while ( pfCompare(pvPivot, *--pRight) < 0 ) { }
+            if ( pLeft >= pRight )
+            {
+                break;
+            }
+            pvTemp = *pLeft;
+            *pLeft = *pRight;
+            *pRight = pvTemp;
+        }
+        apCurr[ 0 ] = *pRight;
+        *pRight = pvPivot;
+
+        if ( (size_t)( pRight - apCurr ) < (size_t)( apCurr + zCurr - pRight - 1 ) )
+        {
+            _listQuickSort(apCurr, (size_t)( pRight - apCurr ), uDepth, pfCompare);
+            zCurr = (size_t)( apCurr + zCurr - pRight - 1 );
+            apCurr = pRight + 1;
+        }
+        else
+        {
+            _listQuickSort(pRight + 1, (size_t)( apCurr + zCurr - pRight - 1 ), uDepth, pfCompare);
+            zCurr = (size_t)( pRight - apCurr );
+        }
+    }
+
+    _listInsertSort(apCurr, zCurr, pfCompare);
+}
+
+static
+void
+_listHeapSort(
+    void ** const apValue,
+    const size_t zCount,
+    int (* const pfCompare)(void *, void *)
+) {
+    void * pvTemp = NULL;
+    size_t idx = 0;
+
+    // ? heapify bottom up, then move the maximum behind the shrinking heap
+    for ( idx = zCount / 2; idx > 0; --idx )
+    {
+        _listSiftDown(apValue, idx - 1, zCount, pfCompare);
+    }
+
+    for ( idx = zCount; idx > 1; --idx )
+    {
+        pvTemp = apValue[ 0 ];
+        apValue[ 0 ] = apValue[ idx - 1 ];
+        apValue[ idx - 1 ] = pvTemp;
+        _listSiftDown(apValue, 0, idx - 1, pfCompare);
+    }
+}
+
+static
+void
+_listSiftDown(
+    void ** const apValue,
+    size_t zRoot,
+    const size_t zEnd,
+    int (* const pfCompare)(void *, void *)
+) {
+    void * pvTemp = NULL;
+    size_t zChild = 0;
+
+    for ( ; ( zChild = 2 * zRoot + 1 ) < zEnd; zRoot = zChild )
+    {
+        if ( zChild + 1 < zEnd && pfCompare(apValue[ zChild ], apValue[ zChild + 1 ]) < 0 )
+        {
+            ++zChild;
+        }
+
+        if ( pfCompare(apValue[ zRoot ], apValue[ zChild ]) >= 0 )
+        {
+            break;
+        }
+
+        pvTemp = apValue[ zRoot ];
+        apValue[ zRoot ] = apValue[ zChild ];
+        apValue[ zChild ] = pvTemp;
+    }
+}
+
+static
+void
+_listInsertSort(
+    void ** const apValue,
+    const size_t zCount,
+    int (* const pfCompare)(void *, void *)
+) {
+    void * pvTemp = NULL;
+    size_t idx = 0;
+    size_t pos = 0;
+
+    // ? stable, only a strictly greater value moves to the right
+    for ( idx = 1; idx < zCount; ++idx )
+    {
+        pvTemp = apValue[ idx ];
+        for ( pos = idx; pos > 0 && pfCompare(pvTemp, apValue[ pos - 1 ]) < 0; --pos )
+        {
+            apValue[ pos ] = apValue[ pos - 1 ];
+        }
+        apValue[ pos ] = pvTemp;
+    }
+}
+
+static
+void **
+_listMergeSort(
+    void ** apValue,
+    void ** apSpare,
+    const size_t zCount,
     int (* const pfCompare)(void *, void *)
 ) {
-    // TODO
+    void ** apTemp = NULL;
+    size_t zWidth = 0;
+    size_t zBegin = 0;
+    size_t zMiddle = 0;
+    size_t zEnd = 0;
+    size_t idx = 0;
+    size_t pos = 0;
+    size_t out = 0;
+
+    // ? bottom up over runs of 16 sorted in place, each pass merges into the spare array and the two swap
+    for ( zBegin = 0; zBegin < zCount; zBegin += 16 )
+    {
+        _listInsertSort(apValue + zBegin, ( zCount - zBegin < 16 ) ? ( zCount - zBegin ) : ( 16 ), pfCompare);
+    }
+
+    for ( zWidth = 16; zWidth < zCount; zWidth *= 2 )
+    {
+        for ( zBegin = 0; zBegin < zCount; zBegin += 2 * zWidth )
+        {
+            zMiddle = ( zCount - zBegin < zWidth ) ? ( zCount ) : ( zBegin + zWidth ) ;
+            zEnd = ( zCount - zMiddle < zWidth ) ? ( zCount ) : ( zMiddle + zWidth ) ;
+
+            // ? the left run wins ties, which keeps the sort stable
+            for ( idx = zBegin, pos = zMiddle, out = zBegin; idx < zMiddle && pos < zEnd; )
+            {
+                apSpare[ out++ ] = ( pfCompare(apValue[ pos ], apValue[ idx ]) < 0 ) ? ( apValue[ pos++ ] ) : ( apValue[ idx++ ] ) ;
+            }
+            memcpy(apSpare + out, apValue + idx, ( zMiddle - idx ) * sizeof(void *));
+            memcpy(apSpare + out + ( zMiddle - idx ), apValue + pos, ( zEnd - pos ) * sizeof(void *));
+        }
+
+        apTemp = apValue;
+        apValue = apSpare;
+        apSpare = apTemp;
+    }
+
+    return apValue;
 }
@@ -46,6 +46,38 @@ listRemove(
     const size_t zIndex
 );
 
+/**
+ * bulk moves, values keep their order and are freed by the receiving list from then on
+ *  - listAppendBatch stops at the first chunk it cannot get, the values it got to stay appended
+ *  - listConcat and listSplice move every value out of psOther and leave it empty, lists of one pool only relink their chunks
+ *  - listSplit moves the values from zIndex on to a new list of the same pool
+ */
+list_s *
+listAppendBatch(
+    list_s * const psRefs,
+    void * const * const apValue,
+    const size_t zCount
+);
+
+list_s *
+listConcat(
+    list_s * const psRefs,
+    list_s * const psOther
+);
+
+list_s *
+listSplice(
+    list_s * const psRefs,
+    const size_t zIndex,
+    list_s * const psOther
+);
+
+list_s *
+listSplit(
+    list_s * const psRefs,
+    const size_t zIndex
+);
+
 list_s *
 listRevert(
     list_s * const psRefs
@@ -56,12 +88,19 @@ listLength(
     list_s const * const psRefs
 );
 
+/* listQuickSort is an introsort, listStableSort a merge sort keeping equal values in order, both need a scratch array of the values */
 list_s * 
 listQuickSort(
     list_s * const psRefs,
     int (* const pfCompare)(void *, void *)
 );
 
+list_s * 
+listStableSort(
+    list_s * const psRefs,
+    int (* const pfCompare)(void *, void *)
+);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
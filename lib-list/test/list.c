@@ -0,0 +1,378 @@
+#include "list.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#define TEST_KEYS ( 4096 )
+#define TEST_MODEL ( 1 << 14 )
+#define TEST_ROUNDS ( 20000 )
+#define TEST_REGION ( (size_t)16 << 20 )
+
+/* counts the failed checks, a check names its line and goes on so one run shows every failure */
+#define TEST_CHECK(cond) _testCheck( (cond), __LINE__, #cond )
+
+/* the list is checked against a plain array of the same values after every step */
+typedef struct {
+    void ** apValue;
+    size_t zLength;
+} test_model_s;
+
+static size_t zFailed = 0;
+static size_t zChecked = 0;
+static uint32_t auKey[ TEST_KEYS ];
+static uint32_t uSeed = 2463534242u;
+
+static
+void
+_testCheck(
+    const bool bPassed,
+    const int iLine,
+    char const * const pText
+) {
+    ++zChecked;
+    if ( false == bPassed )
+    {
+        ++zFailed;
+        fprintf(stderr, "test/list.c:%d: %s\n", iLine, pText);
+    }
+}
+
+static
+uint32_t
+_testRandom(
+    void
+) {
+    uSeed ^= uSeed << 13;
+    uSeed ^= uSeed >> 17;
+    uSeed ^= uSeed << 5;
+    return uSeed;
+}
+
+static
+void *
+_testValue(
+    void
+) {
+    return &auKey[ _testRandom() % TEST_KEYS ];
+}
+
+static
+int
+_testCompare(
+    void * pvLeft,
+    void * pvRight
+) {
+    const uint32_t uLeft = *(uint32_t const *)pvLeft;
+    const uint32_t uRight = *(uint32_t const *)pvRight;
+
+    return ( uLeft > uRight ) - ( uLeft < uRight );
+}
+
+static
+void
+_testNoFree(
+    void * pvValue
+) {
+    (void)pvValue;
+}
+
+static
+void
+_testInsert(
+    test_model_s * const psModel,
+    const size_t zIndex,
+    void * const pvValue
+) {
+    memmove(psModel->apValue + zIndex + 1, psModel->apValue + zIndex, ( psModel->zLength - zIndex ) * sizeof(void *));
+    psModel->apValue[ zIndex ] = pvValue;
+    psModel->zLength++;
+}
+
+static
+void
+_testRemove(
+    test_model_s * const psModel,
+    const size_t zIndex
+) {
+    memmove(psModel->apValue + zIndex, psModel->apValue + zIndex + 1, ( psModel->zLength - zIndex - 1 ) * sizeof(void *));
+    psModel->zLength--;
+}
+
+static
+void
+_testRevert(
+    test_model_s * const psModel
+) {
+    void * pvSwap = NULL;
+    size_t idx = 0;
+
+    for ( idx = 0; idx < psModel->zLength / 2; ++idx )
+    {
+        pvSwap = psModel->apValue[ idx ];
+        psModel->apValue[ idx ] = psModel->apValue[ psModel->zLength - 1 - idx ];
+        psModel->apValue[ psModel->zLength - 1 - idx ] = pvSwap;
+    }
+}
+
+static
+void
+_testSort(
+    test_model_s * const psModel
+) {
+    void * pvValue = NULL;
+    size_t idx = 0;
+    size_t jdx = 0;
+
+    // ? an insertion sort is stable and plainly right, the model stays small enough for it
+    for ( idx = 1; idx < psModel->zLength; ++idx )
+    {
+        pvValue = psModel->apValue[ idx ];
+        for ( jdx = idx; 0 < jdx && 0 < _testCompare(psModel->apValue[ jdx - 1 ], pvValue); --jdx )
+        {
+            psModel->apValue[ jdx ] = psModel->apValue[ jdx - 1 ];
+        }
+        psModel->apValue[ jdx ] = pvValue;
+    }
+}
+
+static
+bool
+_testSame(
+    list_s * const psList,
+    test_model_s const * const psModel,
+    const bool bByKey
+) {
+    size_t zIndex = 0;
+    size_t idx = 0;
+
+    if ( listLength(psList) != psModel->zLength )
+    {
+        return false;
+    }
+
+    // ? walk forwards, then probe at random so the cursor has to jump both ways
+    for ( idx = 0; idx < psModel->zLength; ++idx )
+    {
+        void * const pvValue = listAccess(psList, idx);
+        if ( ( bByKey ) ? ( NULL == pvValue || 0 != _testCompare(pvValue, psModel->apValue[ idx ]) ) : ( pvValue != psModel->apValue[ idx ] ) )
+        {
+            return false;
+        }
+    }
+
+    for ( idx = 0; 0 < psModel->zLength && idx < 64; ++idx )
+    {
+        zIndex = _testRandom() % psModel->zLength;
+        if ( ( bByKey ) ? ( 0 != _testCompare(listAccess(psList, zIndex), psModel->apValue[ zIndex ]) ) : ( listAccess(psList, zIndex) != psModel->apValue[ zIndex ] ) )
+        {
+            return false;
+        }
+    }
+
+    return NULL == listAccess(psList, psModel->zLength);
+}
+
+static
+void
+_testRandomOps(
+    pool_s * const psPool,
+    pool_s * const psOther
+) {
+    list_s * psList = listMake(psPool, _testNoFree);
+    list_s * psMore = NULL;
+    test_model_s sModel = { .apValue = (void **)calloc(TEST_MODEL, sizeof(void *)), .zLength = 0 };
+    void * apBatch[ 300 ];
+    size_t zRound = 0;
+    size_t zIndex = 0;
+    size_t zCount = 0;
+    size_t idx = 0;
+
+    for ( zRound = 0; zRound < TEST_ROUNDS; ++zRound )
+    {
+        zIndex = ( 0 == sModel.zLength ) ? ( 0 ) : ( _testRandom() % ( sModel.zLength + 1 ) ) ;
+
+        switch ( _testRandom() % 16 )
+        {
+            case 0: case 1: case 2: case 3: case 4:
+                apBatch[ 0 ] = _testValue();
+                TEST_CHECK( psList == listInsert(psList, zIndex, apBatch[ 0 ]) );
+                _testInsert(&sModel, zIndex, apBatch[ 0 ]);
+                break;
+
+            case 5: case 6: case 7:
+                if ( zIndex < sModel.zLength )
+                {
+                    TEST_CHECK( psList == listRemove(psList, zIndex) );
+                    _testRemove(&sModel, zIndex);
+                }
+                else
+                {
+                    TEST_CHECK( NULL == listRemove(psList, zIndex) );
+                }
+                break;
+
+            case 8: case 9:
+                apBatch[ 0 ] = _testValue();
+                if ( zIndex < sModel.zLength )
+                {
+                    TEST_CHECK( psList == listChange(psList, zIndex, apBatch[ 0 ]) );
+                    sModel.apValue[ zIndex ] = apBatch[ 0 ];
+                }
+                break;
+
+            case 10:
+                zCount = _testRandom() % 300;
+                for ( idx = 0; idx < zCount; ++idx )
+                {
+                    apBatch[ idx ] = _testValue();
+                    sModel.apValue[ sModel.zLength + idx ] = apBatch[ idx ];
+                }
+                TEST_CHECK( psList == listAppendBatch(psList, apBatch, zCount) );
+                sModel.zLength += zCount;
+                break;
+
+            case 11: case 12:
+                // ? a list of the same pool relinks its chunks, one of another pool copies the values
+                psMore = listMake(( 0 == zRound % 2 ) ? ( psPool ) : ( psOther ), _testNoFree);
+                zCount = _testRandom() % 200;
+                for ( idx = 0; idx < zCount; ++idx )
+                {
+                    apBatch[ idx ] = _testValue();
+                    listInsert(psMore, idx, apBatch[ idx ]);
+                }
+                if ( 0 == zRound % 3 )
+                {
+                    listRevert(psMore);
+                    for ( idx = 0; idx < zCount / 2; ++idx )
+                    {
+                        void * const pvSwap = apBatch[ idx ];
+                        apBatch[ idx ] = apBatch[ zCount - 1 - idx ];
+                        apBatch[ zCount - 1 - idx ] = pvSwap;
+                    }
+                }
+                if ( 0 == zRound % 5 )
+                {
+                    TEST_CHECK( psList == listConcat(psList, psMore) );
+                    zIndex = sModel.zLength;
+                }
+                else
+                {
+                    TEST_CHECK( psList == listSplice(psList, zIndex, psMore) );
+                }
+                for ( idx = 0; idx < zCount; ++idx )
+                {
+                    _testInsert(&sModel, zIndex + idx, apBatch[ idx ]);
+                }
+                TEST_CHECK( 0 == listLength(psMore) );
+                listFree(psMore);
+                break;
+
+            case 13:
+                // ? split off the tail, then glue it back so the model goes on
+                psMore = listSplit(psList, zIndex);
+                TEST_CHECK( NULL != psMore && zIndex == listLength(psList) );
+                if ( NULL != psMore )
+                {
+                    test_model_s sTail = { .apValue = sModel.apValue + zIndex, .zLength = sModel.zLength - zIndex };
+                    TEST_CHECK( _testSame(psMore, &sTail, false) );
+                    TEST_CHECK( psList == listConcat(psList, psMore) );
+                    listFree(psMore);
+                }
+                break;
+
+            case 14:
+                TEST_CHECK( psList == listRevert(psList) );
+                _testRevert(&sModel);
+                break;
+
+            default:
+                TEST_CHECK( listAccess(psList, zIndex) == ( ( zIndex < sModel.zLength ) ? ( sModel.apValue[ zIndex ] ) : ( NULL ) ) );
+                break;
+        }
+
+        if ( 0 == zRound % 257 )
+        {
+            TEST_CHECK( _testSame(psList, &sModel, false) );
+        }
+
+        // ? keep the model bounded
+        while ( TEST_MODEL / 2 < sModel.zLength )
+        {
+            listRemove(psList, sModel.zLength - 1);
+            sModel.zLength--;
+        }
+    }
+    TEST_CHECK( _testSame(psList, &sModel, false) );
+
+    listFree(psList);
+    free(sModel.apValue);
+}
+
+static
+void
+_testSorts(
+    pool_s * const psPool
+) {
+    list_s * const psList = listMake(psPool, _testNoFree);
+    test_model_s sModel = { .apValue = (void **)calloc(TEST_MODEL, sizeof(void *)), .zLength = 0 };
+    const size_t azLength[] = { 0, 1, 2, 17, 500, 3000 };
+    size_t zCase = 0;
+    size_t idx = 0;
+
+    for ( zCase = 0; zCase < sizeof(azLength) / sizeof(azLength[ 0 ]) * 2; ++zCase )
+    {
+        // ? few keys, so there are many equal values whose order the stable sort must keep
+        while ( 0 < listLength(psList) )
+        {
+            listRemove(psList, 0);
+        }
+        sModel.zLength = 0;
+        for ( idx = 0; idx < azLength[ zCase / 2 ]; ++idx )
+        {
+            void * const pvValue = &auKey[ _testRandom() % TEST_KEYS ];
+            listInsert(psList, idx, pvValue);
+            _testInsert(&sModel, idx, pvValue);
+        }
+        if ( 1 == zCase % 2 )
+        {
+            listRevert(psList);
+            _testRevert(&sModel);
+        }
+        _testSort(&sModel);
+
+        TEST_CHECK( psList == listStableSort(psList, _testCompare) );
+        TEST_CHECK( _testSame(psList, &sModel, false) );
+
+        listRevert(psList);
+        TEST_CHECK( psList == listQuickSort(psList, _testCompare) );
+        TEST_CHECK( _testSame(psList, &sModel, true) );
+    }
+
+    listFree(psList);
+    free(sModel.apValue);
+}
+
+int
+main(
+    void
+) {
+    pool_s * const psPool = poolMake(TEST_REGION, PMSegregate, PFNone);
+    pool_s * const psOther = poolMake(TEST_REGION, PMBuddy, PFNone);
+    size_t idx = 0;
+
+    for ( idx = 0; idx < TEST_KEYS; ++idx )
+    {
+        auKey[ idx ] = (uint32_t)( idx % 97 );
+    }
+
+    _testRandomOps(psPool, psOther);
+    _testSorts(psPool);
+
+    poolFree(psOther);
+    poolFree(psPool);
+
+    printf("list: %zu of %zu checks failed\n", zFailed, zChecked);
+    return ( 0 == zFailed ) ? ( 0 ) : ( 1 ) ;
+}
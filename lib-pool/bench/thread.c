@@ -0,0 +1,205 @@
+#include "pool.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <threads.h>
+#include <time.h>
+
+#define BENCH_REGION ( (size_t)64 << 20 )
+#define BENCH_ROUNDS ( 1 << 21 )
+#define BENCH_SLOTS ( 256 )
+#define BENCH_THREAD_MAX ( 64 )
+
+typedef enum { BMMutex, BMShare, BMMalloc } bench_mode_e;
+
+typedef struct {
+    bench_mode_e eMode;
+    pool_s * psPool;
+    mtx_t * psLock;
+    unsigned int uSeed;
+    size_t zFail;
+} bench_arg_s;
+
+static const char * const aModeName[] = { "pool + global mutex", "pool + thread cache", "malloc" };
+
+static
+uint32_t
+_benchRandom(
+    unsigned int * const puSeed
+) {
+    // ? xorshift, cheap enough to stay out of the measure
+    *puSeed ^= *puSeed << 13;
+    *puSeed ^= *puSeed >> 17;
+    *puSeed ^= *puSeed << 5;
+    return *puSeed;
+}
+
+static
+void *
+_benchAlloc(
+    bench_arg_s * const psArg,
+    const size_t zSize
+) {
+    void * pvResult = NULL;
+
+    switch ( psArg->eMode )
+    {
+        case BMMutex:
+            mtx_lock(psArg->psLock);
+            pvResult = poolAlloc(psArg->psPool, zSize);
+            mtx_unlock(psArg->psLock);
+            break;
+        case BMShare:
+            pvResult = poolAlloc(psArg->psPool, zSize);
+            break;
+        case BMMalloc:
+            pvResult = malloc(zSize);
+            break;
+    }
+
+    return pvResult;
+}
+
+static
+void
+_benchErase(
+    bench_arg_s * const psArg,
+    void * const pvTarget
+) {
+    switch ( psArg->eMode )
+    {
+        case BMMutex:
+            mtx_lock(psArg->psLock);
+            poolErase(psArg->psPool, pvTarget);
+            mtx_unlock(psArg->psLock);
+            break;
+        case BMShare:
+            poolErase(psArg->psPool, pvTarget);
+            break;
+        case BMMalloc:
+            free(pvTarget);
+            break;
+    }
+}
+
+static
+int
+_benchWorker(
+    void * pvArg
+) {
+    bench_arg_s * const psArg = (bench_arg_s *)( pvArg );
+    void * apSlot[ BENCH_SLOTS ] = { NULL };
+    uint32_t uRand = 0;
+    size_t idx = 0;
+
+    // ? every round replaces one random slot, so the live set stays around BENCH_SLOTS small blocks
+    for ( idx = 0; idx < BENCH_ROUNDS; ++idx )
+    {
+        uRand = _benchRandom(&psArg->uSeed);
+        if ( NULL != apSlot[ uRand % BENCH_SLOTS ] )
+        {
+            _benchErase(psArg, apSlot[ uRand % BENCH_SLOTS ]);
+        }
+
+        apSlot[ uRand % BENCH_SLOTS ] = _benchAlloc(psArg, 8 + ( ( uRand >> 16 ) % 248 ));
+        if ( NULL == apSlot[ uRand % BENCH_SLOTS ] )
+        {
+            ++psArg->zFail;
+        }
+        else
+        {
+            memset(apSlot[ uRand % BENCH_SLOTS ], (int)idx, 8);
+        }
+    }
+
+    for ( idx = 0; idx < BENCH_SLOTS; ++idx )
+    {
+        if ( NULL != apSlot[ idx ] )
+        {
+            _benchErase(psArg, apSlot[ idx ]);
+        }
+    }
+
+    return 0;
+}
+
+static
+double
+_benchRun(
+    const bench_mode_e eMode,
+    const unsigned int uThreads,
+    size_t * const pzFail
+) {
+    thrd_t asThread[ BENCH_THREAD_MAX ];
+    bench_arg_s asArg[ BENCH_THREAD_MAX ];
+    struct timespec sBegin, sEnd;
+    pool_s * psPool = NULL;
+    mtx_t sLock;
+    unsigned int idx = 0;
+
+    if ( BMMalloc != eMode )
+    {
+        psPool = poolMake(BENCH_REGION, PMSegregate, PFNone);
+        if ( BMShare == eMode )
+        {
+            poolShare(psPool);
+        }
+    }
+    mtx_init(&sLock, mtx_plain);
+
+    timespec_get(&sBegin, TIME_UTC);
+    for ( idx = 0; idx < uThreads; ++idx )
+    {
+        asArg[ idx ].eMode = eMode;
+        asArg[ idx ].psPool = psPool;
+        asArg[ idx ].psLock = &sLock;
+        asArg[ idx ].uSeed = 2463534242u + idx;
+        asArg[ idx ].zFail = 0;
+        thrd_create(&asThread[ idx ], _benchWorker, &asArg[ idx ]);
+    }
+
+    *pzFail = 0;
+    for ( idx = 0; idx < uThreads; ++idx )
+    {
+        thrd_join(asThread[ idx ], NULL);
+        *pzFail += asArg[ idx ].zFail;
+    }
+    timespec_get(&sEnd, TIME_UTC);
+
+    mtx_destroy(&sLock);
+    poolFree(psPool);
+
+    // ? one round is one alloc and one erase, the time is wall clock over all threads
+    return ( ( sEnd.tv_sec - sBegin.tv_sec ) * 1e9 + ( sEnd.tv_nsec - sBegin.tv_nsec ) ) / ( 2.0 * BENCH_ROUNDS * uThreads );
+}
+
+int
+main(
+    int argc,
+    char * argv[]
+) {
+    unsigned int uThreadMax = ( argc > 1 ) ? (unsigned int)atoi(argv[ 1 ]) : ( 8 ) ;
+    unsigned int uThreads = 0;
+    size_t zFail = 0;
+    double dNanos = 0;
+    int eMode = 0;
+
+    if ( 0 == uThreadMax || BENCH_THREAD_MAX < uThreadMax )
+    {
+        fprintf(stderr, "usage: %s [threads, 1 to %d]\n", argv[ 0 ], BENCH_THREAD_MAX);
+        return 1;
+    }
+
+    printf("%-24s %8s %12s %8s\n", "mode", "threads", "ns/op", "fails");
+    for ( uThreads = 1; uThreads <= uThreadMax; uThreads *= 2 )
+    {
+        for ( eMode = BMMutex; eMode <= BMMalloc; ++eMode )
+        {
+            dNanos = _benchRun((bench_mode_e)eMode, uThreads, &zFail);
+            printf("%-24s %8u %12.2f %8zu\n", aModeName[ eMode ], uThreads, dNanos, zFail);
+        }
+    }
+
+    return 0;
+}
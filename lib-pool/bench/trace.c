@@ -0,0 +1,368 @@
+#include "pool.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+#define BENCH_REGION ( (size_t)16 << 20 )
+#define BENCH_LIST_NODES ( 1 << 20 )
+#define BENCH_LIST_ROUNDS ( 4 )
+#define BENCH_CHURN_SLOTS ( 1 << 16 )
+#define BENCH_CHURN_ROUNDS ( 1 << 22 )
+#define BENCH_SLAB_CLASSES ( 512 / 16 + 1 ) /* larger objects go to poolAlloc, as slabs stop at 512 bytes */
+
+typedef enum { BAMalloc, BASegregate, BABuddy, BAShare, BASlab, BAHandle, BANum } bench_alloc_e;
+
+typedef enum { BTList, BTTree, BTWord, BTNum } bench_trace_e;
+
+typedef struct {
+    bench_alloc_e eAlloc;
+    pool_s * psPool;
+    slab_s * apSlab[ BENCH_SLAB_CLASSES ];
+    unsigned int uSeed;
+    size_t zOps;
+    size_t zFail;
+    unsigned int uFragment;
+} bench_arg_s;
+
+typedef struct {
+    double dNanos;
+    size_t zFail;
+    unsigned int uFragment;
+} bench_result_s;
+
+static const char * const aAllocName[] = { "malloc", "pool segregate", "pool buddy", "pool shared", "slab per size", "pool handle" };
+
+static const char * const aTraceName[] = { "list build/teardown", "tree churn", "mixed words" };
+
+static
+uint32_t
+_benchRandom(
+    unsigned int * const puSeed
+) {
+    // ? xorshift, cheap enough to stay out of the measure
+    *puSeed ^= *puSeed << 13;
+    *puSeed ^= *puSeed >> 17;
+    *puSeed ^= *puSeed << 5;
+    return *puSeed;
+}
+
+static
+uintptr_t
+_benchAlloc(
+    bench_arg_s * const psArg,
+    const size_t zSize
+) {
+    uintptr_t uResult = 0;
+    const size_t idx = ( zSize + 15 ) / 16;
+
+    switch ( psArg->eAlloc )
+    {
+        case BAMalloc:
+            uResult = (uintptr_t)malloc(zSize);
+            break;
+        case BASegregate:
+        case BABuddy:
+        case BAShare:
+            uResult = (uintptr_t)poolAlloc(psArg->psPool, zSize);
+            break;
+        case BASlab:
+            // ? one slab per 16 byte class, made the first time the class is asked for
+            if ( BENCH_SLAB_CLASSES <= idx )
+            {
+                uResult = (uintptr_t)poolAlloc(psArg->psPool, zSize);
+                break;
+            }
+            if ( NULL == psArg->apSlab[ idx ] )
+            {
+                psArg->apSlab[ idx ] = slabMake(psArg->psPool, 16 * idx);
+            }
+            uResult = (uintptr_t)slabAlloc(psArg->apSlab[ idx ]);
+            break;
+        case BAHandle:
+            uResult = (uintptr_t)poolHandleAlloc(psArg->psPool, zSize);
+            break;
+        default:
+            break;
+    }
+
+    ++psArg->zOps;
+    if ( 0 == uResult )
+    {
+        ++psArg->zFail;
+    }
+    else if ( BAHandle != psArg->eAlloc )
+    {
+        *(char *)uResult = 0; /* touch the block like a real caller would */
+    }
+
+    return uResult;
+}
+
+static
+void
+_benchErase(
+    bench_arg_s * const psArg,
+    const uintptr_t uTarget,
+    const size_t zSize
+) {
+    const size_t idx = ( zSize + 15 ) / 16;
+
+    if ( 0 == uTarget )
+    {
+        return;
+    }
+
+    switch ( psArg->eAlloc )
+    {
+        case BAMalloc:
+            free((void *)uTarget);
+            break;
+        case BASegregate:
+        case BABuddy:
+        case BAShare:
+            poolErase(psArg->psPool, (void *)uTarget);
+            break;
+        case BASlab:
+            if ( BENCH_SLAB_CLASSES <= idx )
+            {
+                poolErase(psArg->psPool, (void *)uTarget);
+                break;
+            }
+            slabErase(psArg->apSlab[ idx ], (void *)uTarget);
+            break;
+        case BAHandle:
+            poolHandleErase(psArg->psPool, (pool_handle_t)uTarget);
+            break;
+        default:
+            break;
+    }
+
+    ++psArg->zOps;
+}
+
+static
+void
+_benchSample(
+    bench_arg_s * const psArg
+) {
+    // ? fragmentation is read at the peak of the live set, handles are compacted first since that is their point
+    if ( NULL == psArg->psPool )
+    {
+        return;
+    }
+
+    if ( BAHandle == psArg->eAlloc )
+    {
+        poolCompact(psArg->psPool);
+    }
+    psArg->uFragment = poolFragment(psArg->psPool);
+}
+
+static
+void
+_benchList(
+    bench_arg_s * const psArg
+) {
+    uintptr_t * const auNode = (uintptr_t *)calloc(BENCH_LIST_NODES, sizeof(uintptr_t));
+    size_t idx = 0;
+    int round = 0;
+
+    // ? a list node is a value and a xor link, built at the tail and freed from the head
+    for ( round = 0; round < BENCH_LIST_ROUNDS; ++round )
+    {
+        for ( idx = 0; idx < BENCH_LIST_NODES; ++idx )
+        {
+            auNode[ idx ] = _benchAlloc(psArg, 2 * sizeof(void *));
+        }
+
+        if ( 0 == round )
+        {
+            _benchSample(psArg);
+        }
+
+        for ( idx = 0; idx < BENCH_LIST_NODES; ++idx )
+        {
+            _benchErase(psArg, auNode[ idx ], 2 * sizeof(void *));
+        }
+    }
+
+    free(auNode);
+}
+
+static
+void
+_benchChurn(
+    bench_arg_s * const psArg,
+    const bench_trace_e eTrace
+) {
+    uintptr_t * const auSlot = (uintptr_t *)calloc(BENCH_CHURN_SLOTS, sizeof(uintptr_t));
+    size_t * const azSize = (size_t *)calloc(BENCH_CHURN_SLOTS, sizeof(size_t));
+    uint32_t uRand = 0;
+    size_t zSize = 0;
+    size_t idx = 0;
+
+    // ? every round replaces one random slot, a tree node is 40 bytes and a word its struct plus mostly short text
+    for ( idx = 0; idx < BENCH_CHURN_ROUNDS; ++idx )
+    {
+        uRand = _benchRandom(&psArg->uSeed);
+        zSize = ( BTTree == eTrace ) ?
+            ( 40 ) :
+            ( ( 0 == ( uRand >> 26 ) % 64 ) ?
+                ( 24 + 1 + ( uRand >> 8 ) % 4096 ) :
+                ( 24 + 1 + ( uRand >> 8 ) % ( (size_t)1 << ( ( uRand >> 20 ) % 8 ) ) ) ) ;
+
+        _benchErase(psArg, auSlot[ uRand % BENCH_CHURN_SLOTS ], azSize[ uRand % BENCH_CHURN_SLOTS ]);
+        auSlot[ uRand % BENCH_CHURN_SLOTS ] = _benchAlloc(psArg, zSize);
+        azSize[ uRand % BENCH_CHURN_SLOTS ] = zSize;
+    }
+
+    _benchSample(psArg);
+
+    for ( idx = 0; idx < BENCH_CHURN_SLOTS; ++idx )
+    {
+        _benchErase(psArg, auSlot[ idx ], azSize[ idx ]);
+    }
+
+    free(azSize);
+    free(auSlot);
+}
+
+static
+void
+_benchChild(
+    const bench_trace_e eTrace,
+    const bench_alloc_e eAlloc,
+    const int iPipe
+) {
+    bench_arg_s sArg;
+    bench_result_s sResult;
+    struct timespec sBegin, sEnd;
+    size_t idx = 0;
+
+    memset(&sArg, 0, sizeof(sArg));
+    sArg.eAlloc = eAlloc;
+    sArg.uSeed = 2463534242u;
+
+    if ( BAMalloc != eAlloc )
+    {
+        sArg.psPool = poolMake(BENCH_REGION, ( BABuddy == eAlloc ) ? ( PMBuddy ) : ( PMSegregate ), PFNone);
+        if ( BAShare == eAlloc )
+        {
+            poolShare(sArg.psPool);
+        }
+    }
+
+    timespec_get(&sBegin, TIME_UTC);
+    switch ( eTrace )
+    {
+        case BTList:
+            _benchList(&sArg);
+            break;
+        default:
+            _benchChurn(&sArg, eTrace);
+            break;
+    }
+    timespec_get(&sEnd, TIME_UTC);
+
+    for ( idx = 0; idx < BENCH_SLAB_CLASSES; ++idx )
+    {
+        slabFree(sArg.apSlab[ idx ]);
+    }
+    poolFree(sArg.psPool);
+
+    sResult.dNanos = ( ( sEnd.tv_sec - sBegin.tv_sec ) * 1e9 + ( sEnd.tv_nsec - sBegin.tv_nsec ) ) / (double)sArg.zOps;
+    sResult.zFail = sArg.zFail;
+    sResult.uFragment = sArg.uFragment;
+
+    if ( sizeof(sResult) != write(iPipe, &sResult, sizeof(sResult)) )
+    {
+        _exit(1);
+    }
+    _exit(0);
+}
+
+static
+int
+_benchRun(
+    const bench_trace_e eTrace,
+    const bench_alloc_e eAlloc,
+    bench_result_s * const psResult,
+    long * const plPeakRss
+) {
+    struct rusage sUsage;
+    int aiPipe[ 2 ];
+    int iStatus = 0;
+    pid_t iChild = 0;
+    ssize_t iRead = 0;
+
+    // ? each run gets a fresh process, so its peak rss is its own
+    if ( 0 != pipe(aiPipe) )
+    {
+        return -1;
+    }
+
+    iChild = fork();
+    if ( 0 > iChild )
+    {
+        close(aiPipe[ 0 ]);
+        close(aiPipe[ 1 ]);
+        return -1;
+    }
+
+    if ( 0 == iChild )
+    {
+        close(aiPipe[ 0 ]);
+        _benchChild(eTrace, eAlloc, aiPipe[ 1 ]);
+    }
+
+    close(aiPipe[ 1 ]);
+    iRead = read(aiPipe[ 0 ], psResult, sizeof(*psResult));
+    close(aiPipe[ 0 ]);
+
+    if ( iChild != wait4(iChild, &iStatus, 0, &sUsage) || !WIFEXITED(iStatus) || 0 != WEXITSTATUS(iStatus) || sizeof(*psResult) != iRead )
+    {
+        return -1;
+    }
+
+    *plPeakRss = sUsage.ru_maxrss;
+    return 0;
+}
+
+int
+main(
+    void
+) {
+    bench_result_s sResult;
+    long lPeakRss = 0;
+    int eTrace = 0;
+    int eAlloc = 0;
+
+    printf("%-20s %-16s %10s %14s %10s %8s\n", "trace", "allocator", "ns/op", "peak rss kb", "frag 1/k", "fails");
+    for ( eTrace = BTList; eTrace < BTNum; ++eTrace )
+    {
+        for ( eAlloc = BAMalloc; eAlloc < BANum; ++eAlloc )
+        {
+            if ( 0 != _benchRun((bench_trace_e)eTrace, (bench_alloc_e)eAlloc, &sResult, &lPeakRss) )
+            {
+                printf("%-20s %-16s %10s\n", aTraceName[ eTrace ], aAllocName[ eAlloc ], "failed");
+                continue;
+            }
+
+            if ( BAMalloc == eAlloc )
+            {
+                printf("%-20s %-16s %10.2f %14ld %10s %8zu\n", aTraceName[ eTrace ], aAllocName[ eAlloc ], sResult.dNanos, lPeakRss, "-", sResult.zFail);
+            }
+            else
+            {
+                printf("%-20s %-16s %10.2f %14ld %10u %8zu\n", aTraceName[ eTrace ], aAllocName[ eAlloc ], sResult.dNanos, lPeakRss, sResult.uFragment, sResult.zFail);
+            }
+        }
+    }
+
+    return 0;
+}
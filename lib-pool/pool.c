@@ -1,16 +1,169 @@
 #include "pool.h"
 #include <assert.h>
+#include <errno.h>
 #include <stdbool.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <threads.h>
 
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define POOL_DEGREE_MIN ( 4 )
+#define POOL_DEGREE_MAX ( 30 )
+#define POOL_DEGREE_NUM ( POOL_DEGREE_MAX - POOL_DEGREE_MIN + 1 )
+
+_Static_assert( POOL_STATS_DEGREE_NUM == POOL_DEGREE_NUM, "one histogram slot per block degree" );
+
+#define POOL_BLOCK(deg) ( (size_t)1 << (deg) )
+
+/* offsets are kept in grains of the smallest block, nextDiff is the narrowest field */
+#define POOL_GRAIN(offset) ( (uint32_t)( (offset) >> POOL_DEGREE_MIN ) )
+#define POOL_BYTES(grain) ( (size_t)(grain) << POOL_DEGREE_MIN )
+#define POOL_SPAN_MAX POOL_BYTES( (uint32_t)1 << 27 )
+
+/* a file pool starts with a file_s, the pool is formatted right behind it */
+#define POOL_FILE_MAGIC ( UINT64_C(0x4C4F4F504854594D) ) /* "MYTHPOOL" on a little endian host */
+#define POOL_FILE_VERSION ( 1 )
+#define POOL_FLAG_FILE ( 1u << 31 ) /* internal, never a pool_flag_e */
+#define POOL_FLAG_LOOSE ( 1u << 30 ) /* internal, blocks were erased into the free lists since they were last merged */
+#define POOL_FLAG_SHELF ( 1u << 29 ) /* internal, blocks in front of the checkpoint were freed under it, some may be left off the lists */
+
+/* payloads follow an 8 bytes header, a wider alignment puts a shim header in front of the aligned payload */
+#define POOL_ALIGN_MAX ( 64 )
+
+/* a thread keeps up to POOL_CACHE_SIZE blocks of each small degree, and trades half of them with the pool at once */
+#define POOL_CACHE_DEGREE_MAX ( 10 )
+#define POOL_CACHE_NUM ( POOL_CACHE_DEGREE_MAX - POOL_DEGREE_MIN + 1 )
+#define POOL_CACHE_SIZE ( 32 )
+
+/* slab objects are carved from 4 KB blocks, and are word aligned */
+#define SLAB_PAGE_DEGREE ( 12 )
+#define SLAB_OBJECT_MAX ( 512 )
+#define SLAB_ALIGN(size) ( ( (size) + sizeof(void *) - 1 ) & ~( sizeof(void *) - 1 ) )
+
+/**
+ * blocks tile the buffer from psHead up to zFrontier, each one is ( 1 << shiftDeg ) bytes
+ *  - allocated: headDiff is the offset from psHead, nextDiff is 0
+ *  - free: headDiff is 0, nextDiff is the offset of the next free block with the same degree (0 = end of list),
+ *          and the first payload bytes hold the offset of the previous one
+ *
+ * a list keeps the blocks beyond the checkpoint in front of the others, a block in front of it that cannot go behind them is
+ * left off the lists with a zero link to its previous block, and the lists are rebuilt when the checkpoint is released
+ *
+ * in segregated mode an erased block is only listed, the runs of free blocks are merged and cut again into powers of two
+ * by a walk over the region when an allocation finds no block, and only if something was erased since the last walk
+ *
+ * in buddy mode every block is also aligned to its own size, counted from the first block
+ *
+ * a shim has shiftDeg 0, headDiff is the one of its block and nextDiff the distance from the block payload
+ * a block owned by a handle keeps the handle in nextDiff, poolCompact may move it
+ * a block parked in a thread cache keeps its header with nextDiff POOL_PARKED, so it still looks allocated and pinned
+ */
 typedef struct {
-    unsigned int headDiff : 14;
-    unsigned int nextDiff : 14;
-    unsigned int shiftDeg : 4;
+    uint32_t headDiff;
+    uint32_t nextDiff : 27;
+    uint32_t shiftDeg : 5;
 } node_s;
 
+/* the blocks keep offsets, but the payload may hold pointers, so the file is mapped back at uBase */
+typedef struct {
+    uint64_t uMagic;
+    uint32_t uVersion;
+    uint32_t uHeader; /* sizeof(file_s), the pool follows */
+    uint64_t uSize; /* size of the whole file */
+    uint64_t uBase; /* address of the mapping */
+    uint64_t uRoot; /* offset of the root payload from the pool, 0 if none */
+    uint64_t aReserved[ 3 ];
+} file_s;
+
+/* handle h is aEntry[ h - 1 ], an unused entry holds ( next unused handle << 1 | 1 ) */
+typedef struct {
+    uint32_t uSize;
+    uint32_t uFree; /* first unused handle, 0 if none */
+    uintptr_t aEntry[];
+} handle_s;
+
+#define POOL_PARKED ( ( (uint32_t)1 << 27 ) - 1 ) /* nextDiff of a block parked in a thread cache */
+#define POOL_HANDLE_MAX ( POOL_PARKED - 1 )
+
+typedef struct cache_s cache_s;
+
+/* blocks parked by one thread, they still count as used until they go back to the pool */
+struct cache_s {
+    pool_s * psPool;
+    cache_s * psPrev;
+    cache_s * psNext;
+    unsigned int uEpoch;
+    unsigned int aCount[ POOL_CACHE_NUM ];
+    void * aapBlock[ POOL_CACHE_NUM ][ POOL_CACHE_SIZE ];
+};
+
+typedef struct {
+    mtx_t sLock;
+    tss_t sCache; /* cache_s of the calling thread */
+    atomic_uint uEpoch; /* bumped when the pool is reset, so the caches drop their blocks too */
+    cache_s * psCaches;
+} share_s;
+
+/* objects of one size, pages and erased objects are chained through their first word */
+struct slab_s {
+    pool_s * psPool;
+    slab_s * psNext; /* next slab of the same pool */
+    size_t zSize;
+    size_t zRefs;
+    void * pvPages;
+    void * pvFree;
+    char * pCarve; /* untouched part of the newest page */
+    char * pCarveEnd;
+    char ** apIndex; /* the pages sorted by address in a block of the pool, NULL until an erase needs it */
+    size_t zIndex;
+    char * pLastPage; /* page of the last erase, the next one is likely to hit it again */
+};
+
+/* slabs as they were at a checkpoint, a slab is sealed by it and carves new pages until it is released */
+typedef struct slab_mark_s slab_mark_s;
+struct slab_mark_s {
+    slab_mark_s * psOuter;
+    size_t zCount;
+    struct {
+        slab_s * psSlab; /* NULL once the slab is freed */
+        void * pvFree;
+        char * pCarve;
+        char * pCarveEnd;
+    } asSlab[];
+};
+
+/* state of the process using the pool, kept by the first region, a file pool keeps it in front of the mapping instead */
+typedef struct {
+    pool_s * psMarkRegion; /* region of the innermost checkpoint, the regions before it are frozen */
+    share_s * psShare; /* lock and thread caches, NULL if the pool is not shared */
+    slab_mark_s * psSlabMark; /* slabs as they were at the innermost checkpoint, NULL if none */
+    handle_s * psHandles; /* handle table of this process, NULL until the first handle */
+} local_s;
+
 typedef struct {
-    node_s * psBoundary; 
+    pool_mode_e eMode;
+    unsigned int uFlags;
+    size_t zRegion; /* size of the next mapped region, 0 if the pool cannot grow */
+    pool_s * psNext; /* next mapped region */
+    local_s sLocal; /* read through _poolLocalOf, never by a file pool */
+    slab_s * psSlabs; /* slabs made on this pool, they live in its blocks */
+    node_s * psBoundary;
+    size_t zFrontier; /* offset of the first byte never handed out */
+    size_t zFloor; /* nothing below this offset is handed out while a checkpoint is active */
     size_t zUsage;
+    uint32_t aFreeList[ POOL_DEGREE_NUM ]; /* offset of the first free block per degree */
+    uint32_t uFreeMap; /* bit ( deg - POOL_DEGREE_MIN ) is set if that free list is not empty */
+    size_t zLive; /* bytes of the blocks handed out by all regions, kept by the first one with the counters below */
+    size_t zPeak;
+    size_t zAllocs;
+    size_t zErases;
+    size_t zFails;
 } info_s;
 
 struct pool_s {
@@ -18,54 +171,314 @@ struct pool_s {
     info_s psInfo;
 };
 
-static 
-unsigned int 
-_poolComputeShiftDegree(
-    const size_t zSize
+static unsigned int _poolComputeShiftDegree(const size_t zSize);
+static void _poolClear(pool_s * const psRefs);
+static void * _poolAllocRegion(pool_s * const psRefs, const unsigned int shiftDeg);
+static pool_s * _poolEraseRegion(pool_s * const psRefs, node_s * psNode);
+static pool_s * _poolRegionOf(pool_s const * const psRefs, void const * const pvTarget);
+static pool_s * _poolMapRegion(const size_t zSize, const pool_mode_e eMode, const unsigned int uFlags);
+static pool_s * _poolGrow(pool_s * const psRefs, const unsigned int shiftDeg);
+static void _poolIdle(pool_s * const psRefs);
+static void _poolTruncate(pool_s * const psRefs, const size_t zFrontier);
+static node_s * _poolNodeAt(pool_s const * const psRefs, const size_t zOffset);
+static size_t _poolOffsetOf(pool_s const * const psRefs, node_s const * const psNode);
+static node_s * _poolSearch(pool_s const * const psRefs, void const * const pvTarget);
+static void _poolPushFree(pool_s * const psRefs, node_s * const psNode, const unsigned int shiftDeg);
+static node_s * _poolPopFree(pool_s * const psRefs, const unsigned int shiftDeg);
+static void _poolDropFree(pool_s * const psRefs, node_s * const psNode);
+static uint32_t * _poolPrevFree(node_s * const psNode);
+static node_s * _poolTakeFree(pool_s * const psRefs, const unsigned int shiftDeg);
+static node_s * _poolTakeFrontier(pool_s * const psRefs, const unsigned int shiftDeg);
+static node_s * _poolTakeBuddyFrontier(pool_s * const psRefs, const unsigned int shiftDeg);
+static node_s * _poolMergeBuddy(pool_s * const psRefs, node_s * psNode);
+static void _poolMergeRegion(pool_s * const psRefs);
+static void _poolTrimBuddy(pool_s * const psRefs);
+static bool _poolListed(pool_s const * const psRefs, node_s * const psNode);
+static size_t _poolLargestFree(pool_s const * const psRefs);
+static void * _poolAllocChain(pool_s * const psRefs, const unsigned int shiftDeg);
+static pool_s * _poolEraseChain(pool_s * const psRefs, void * const pvTarget);
+static void * _poolAllocShared(pool_s * const psRefs, const unsigned int shiftDeg);
+static pool_s * _poolEraseShared(pool_s * const psRefs, void * const pvTarget);
+static cache_s * _poolCacheOf(pool_s * const psRefs);
+static void _poolCacheDrop(void * pvCache);
+static void _poolCacheFlush(pool_s * const psRefs);
+static void _poolLock(pool_s const * const psRefs);
+static void _poolUnlock(pool_s const * const psRefs);
+static bool _poolExtend(pool_s * const psRefs, node_s * const psNode, const unsigned int shiftDeg);
+static void _poolShrink(pool_s * const psRefs, node_s * const psNode, const unsigned int shiftDeg);
+static void * _poolAllocAligned(pool_s * const psRefs, const size_t zAllocSize, const size_t zAlign);
+static void * _poolHandleOf(pool_s const * const psRefs, const pool_handle_t uHandle);
+static pool_handle_t _poolHandleTake(pool_s * const psRefs);
+static void _poolHandleDrop(pool_s * const psRefs, const pool_handle_t uHandle);
+static void _poolReleaseHandles(pool_s * const psRefs, pool_mark_s const * const psMark);
+static void _poolCompactRegion(pool_s * const psRefs, pool_s * const psRegion);
+static size_t _poolPushGap(pool_s * const psRefs, size_t zBegin, const size_t zEnd);
+static int _poolOpenFile(char const * const pPath, const size_t zFileSize, const unsigned int uFlags, size_t * const pzSize, bool * const pbMade);
+static pool_s * _poolMapFile(const int fd, const size_t zSize, const pool_mode_e eMode, const unsigned int uFlags, const bool bCreate);
+static bool _poolCheck(pool_s const * const psRefs, const size_t zSize);
+static bool _poolCheckSlabs(pool_s const * const psRefs);
+static bool _poolSlabOwns(slab_s * const psSlab, void const * const pvTarget);
+static void _poolSlabIndex(slab_s * const psSlab);
+static void _poolSlabInsert(slab_s * const psSlab, char * const pPage);
+static size_t _poolSlabFind(char * const * const apPage, const size_t zPageNum, char const * const pTarget);
+static node_s * _poolCheckBlock(pool_s const * const psRefs, void const * const pvTarget);
+static int _poolComparePage(void const * pvLeft, void const * pvRight);
+static file_s * _poolFileOf(pool_s const * const psRefs);
+static local_s * _poolLocalOf(pool_s const * const psRefs);
+static void _poolCount(pool_s const * const psRefs, size_t * const azUsed, size_t * const azFree);
+static bool _poolDropped(pool_mark_s const * const psMark, void const * const pvTarget);
+static slab_mark_s * _poolMarkSlabs(pool_s * const psRefs);
+static void _poolReleaseSlabs(pool_s * const psRefs, pool_mark_s const * const psMark);
+
+/* public */
+pool_s *
+poolFormat(
+    void * const pvBuffer,
+    const size_t zBufferSize
 ) {
-    unsigned int deg;
-    size_t zDeg;
+    return poolFormatMode(pvBuffer, zBufferSize, PMSegregate);
+}
+
+pool_s *
+poolFormatMode(
+    void * const pvBuffer,
+    const size_t zBufferSize,
+    const pool_mode_e eMode
+) {
+    pool_s * psRefs = NULL;
+    unsigned int shiftDeg = 0;
 
-    if ( zSize > ( 1 << 14 ) )
+    shiftDeg = _poolComputeShiftDegree( sizeof(pool_s) );
+    if ( NULL == pvBuffer || POOL_BLOCK(shiftDeg) > zBufferSize )
     {
-        // ! error: too large
-        return 0;
+        return NULL;
+    }
+
+    if ( PMSegregate != eMode && PMBuddy != eMode )
+    {
+        return NULL;
+    }
+
+    psRefs = (pool_s *)( pvBuffer );
+    psRefs->psInfo.eMode = eMode;
+    psRefs->psInfo.uFlags = PFNone;
+    psRefs->psInfo.zRegion = 0;
+    psRefs->psInfo.psNext = NULL;
+    _poolLocalOf(psRefs)->psMarkRegion = NULL;
+    _poolLocalOf(psRefs)->psShare = NULL;
+    psRefs->psInfo.psSlabs = NULL;
+    _poolLocalOf(psRefs)->psSlabMark = NULL;
+    _poolLocalOf(psRefs)->psHandles = NULL;
+    psRefs->psInfo.zLive = psRefs->psInfo.zPeak = 0;
+    psRefs->psInfo.zAllocs = psRefs->psInfo.zErases = psRefs->psInfo.zFails = 0;
+
+    psRefs->psHead.headDiff = 0;
+    psRefs->psHead.nextDiff = 0;
+    psRefs->psHead.shiftDeg = shiftDeg;
+
+    // ? the free-list links are 27-bit wide, so the tail of a huge buffer is out of reach
+    psRefs->psInfo.psBoundary = ( zBufferSize > POOL_SPAN_MAX ) ?
+        _poolNodeAt( psRefs, POOL_SPAN_MAX ) :
+        (node_s *)( (char *)pvBuffer + zBufferSize ) ;
+
+    _poolClear(psRefs);
+    return psRefs;
+}
+
+pool_s *
+poolMake(
+    const size_t zRegionSize,
+    const pool_mode_e eMode,
+    const unsigned int uFlags
+) {
+    pool_s * psRefs = NULL;
+
+    if ( 0 == zRegionSize || zRegionSize > POOL_SPAN_MAX )
+    {
+        return NULL;
+    }
+
+    psRefs = _poolMapRegion(zRegionSize, eMode, uFlags);
+    if ( NULL != psRefs )
+    {
+        psRefs->psInfo.zRegion = poolTotal(psRefs);
+    }
+
+    return psRefs;
+}
+
+pool_s *
+poolOpen(
+    char const * const pPath,
+    const size_t zFileSize,
+    const pool_mode_e eMode,
+    const unsigned int uFlags
+) {
+    pool_s * psRefs = NULL;
+    size_t zSize = 0;
+    bool bMade = false;
+    int fd = -1;
+
+    if ( NULL == pPath )
+    {
+        return NULL;
+    }
+
+    fd = _poolOpenFile(pPath, zFileSize, uFlags, &zSize, &bMade);
+    if ( 0 <= fd )
+    {
+        // ? an empty file is formatted, anything else has to be a pool made by poolOpen
+        psRefs = ( 0 == zSize ) ?
+            _poolMapFile(fd, zFileSize, eMode, uFlags, true) :
+            _poolMapFile(fd, zSize, eMode, uFlags, false) ;
+
+        close(fd); /* the mapping keeps the file */
+    }
+
+    if ( NULL == psRefs && bMade )
+    {
+        // ! error: the pool could not be made, so neither is the file
+        unlink(pPath);
+    }
+
+    return psRefs;
+}
+
+void *
+poolRoot(
+    pool_s const * const psRefs
+) {
+    if ( NULL == psRefs || 0 == ( POOL_FLAG_FILE & psRefs->psInfo.uFlags ) || 0 == _poolFileOf(psRefs)->uRoot )
+    {
+        return NULL;
+    }
+
+    return (char *)psRefs + _poolFileOf(psRefs)->uRoot;
+}
+
+pool_s *
+poolRootChange(
+    pool_s * const psRefs,
+    void * const pvRoot
+) {
+    if ( NULL == psRefs || 0 == ( POOL_FLAG_FILE & psRefs->psInfo.uFlags ) )
+    {
+        // ! error: only a file pool keeps a root
+        return NULL;
+    }
+
+    _poolLock(psRefs);
+
+    if ( NULL != pvRoot && NULL == _poolSearch(psRefs, pvRoot) )
+    {
+        // ! error: not an allocated block of this pool
+        _poolUnlock(psRefs);
+        return NULL;
+    }
+
+    _poolFileOf(psRefs)->uRoot = ( NULL == pvRoot ) ? ( 0 ) : (uint64_t)( (char *)pvRoot - (char *)psRefs );
+
+    _poolUnlock(psRefs);
+    return psRefs;
+}
+
+void
+poolFree(
+    void * pvRefs
+) {
+    pool_s * psRefs = (pool_s *)( pvRefs );
+    pool_s * psNext = NULL;
+    share_s * psShare = NULL;
+    cache_s * psCache = NULL;
+    size_t zPage = 0;
+
+    if ( NULL == psRefs )
+    {
+        return;
+    }
+
+    psShare = _poolLocalOf(psRefs)->psShare;
+    if ( NULL != psShare )
+    {
+        // ? the pool owns the cache of every thread, the other threads are done with it but may live on
+        // ? so their caches are freed here, and the deleted key never runs their destructors later
+        tss_delete(psShare->sCache);
+        while ( NULL != psShare->psCaches )
+        {
+            psCache = psShare->psCaches;
+            psShare->psCaches = psCache->psNext;
+            free(psCache);
+        }
+
+        mtx_destroy(&psShare->sLock);
+        free(psShare);
+        _poolLocalOf(psRefs)->psShare = NULL;
     }
 
-    /* check degree [3, 14] */
-    for ( deg = 13; deg > 3; --deg )
+    free(_poolLocalOf(psRefs)->psHandles);
+    _poolLocalOf(psRefs)->psHandles = NULL;
+
+    if ( 0 != ( POOL_FLAG_FILE & psRefs->psInfo.uFlags ) )
     {
-        zDeg = ( 1 << deg );
-        if ( 0 != ( zDeg & zSize ) )
+        // ? a shared mapping writes back to the file, a private one just goes away, with the private page in front
+        zPage = (size_t)sysconf(_SC_PAGESIZE);
+        if ( 0 == ( PFPrivate & psRefs->psInfo.uFlags ) )
         {
-            return ( zDeg == zSize ) ? ( deg ) : ( deg + 1 ) ;
+            msync(_poolFileOf(psRefs), (size_t)_poolFileOf(psRefs)->uSize, MS_SYNC);
         }
+        munmap((char *)_poolFileOf(psRefs) - zPage, zPage + (size_t)_poolFileOf(psRefs)->uSize);
+        return;
     }
 
-    return deg; /* if less than 8 bytes, then assign 8 bytes = ( 1 << 3 ) */
+    if ( 0 == psRefs->psInfo.zRegion )
+    {
+        return; /* the buffer of a formatted pool belongs to the caller */
+    }
+
+    while ( NULL != psRefs )
+    {
+        psNext = psRefs->psInfo.psNext;
+        munmap(psRefs, (size_t)( (char *)psRefs->psInfo.psBoundary - (char *)psRefs ));
+        psRefs = psNext;
+    }
 }
 
 pool_s *
-poolFormat(
-    void * const pvBuffer,
-    const size_t zBufferSize
+poolShare(
+    pool_s * const psRefs
 ) {
-    pool_s * psRefs = NULL;
+    share_s * psShare = NULL;
+
+    if ( NULL == psRefs || NULL != _poolLocalOf(psRefs)->psShare )
+    {
+        return psRefs;
+    }
 
-    if ( NULL == pvBuffer || sizeof(pool_s) > zBufferSize )
+    psShare = (share_s *)malloc( sizeof(share_s) );
+    if ( NULL == psShare )
     {
+        // ! error: memory not avalible
         return NULL;
     }
 
-    psRefs = (pool_s *)( pvBuffer );
+    // ? recursive, so the public calls can be nested under the lock
+    if ( thrd_success != mtx_init(&psShare->sLock, mtx_plain | mtx_recursive) )
+    {
+        free(psShare);
+        return NULL;
+    }
 
-    psRefs->psHead.headDiff = 0;
-    psRefs->psHead.nextDiff = 0;
-    psRefs->psHead.shiftDeg = _poolComputeShiftDegree( sizeof(pool_s) );
+    if ( thrd_success != tss_create(&psShare->sCache, _poolCacheDrop) )
+    {
+        mtx_destroy(&psShare->sLock);
+        free(psShare);
+        return NULL;
+    }
 
-    psRefs->psInfo.psBoundary = (node_s *)( (char *)pvBuffer + zBufferSize );
-    psRefs->psInfo.zUsage = ( 1 << psRefs->psHead.shiftDeg );
+    atomic_init(&psShare->uEpoch, 0);
+    psShare->psCaches = NULL;
 
+    _poolLocalOf(psRefs)->psShare = psShare;
     return psRefs;
 }
 
@@ -74,66 +487,54 @@ poolAlloc(
     pool_s * const psRefs,
     const size_t zAllocSize
 ) {
-    node_s * psPrevNode = NULL;
-    node_s * psCurrNode = NULL;
-    node_s * psNextNode = NULL;
-    node_s * psTempNode = NULL;
-    node_s * psFakeNode = NULL;
     unsigned int shiftDeg = 0;
 
-    if ( NULL == psRefs || 0 == zAllocSize || zAllocSize > ( 1 << 14 ) )
+    if ( NULL == psRefs || 0 == zAllocSize )
     {
         return NULL;
     }
 
-    shiftDeg = _poolComputeShiftDegree( sizeof(node_s) + zAllocSize );
+    shiftDeg = ( zAllocSize > POOL_BLOCK(POOL_DEGREE_MAX) - sizeof(node_s) ) ?
+        ( 0 ) :
+        _poolComputeShiftDegree( sizeof(node_s) + zAllocSize ) ;
     if ( 0 == shiftDeg )
     {
-        // ! error: out of range, access addr more then 16kB.
+        // ! error: out of range, larger than the biggest block
+        _poolLock(psRefs);
+        ++psRefs->psInfo.zFails;
+        _poolUnlock(psRefs);
         return NULL;
     }
-    
-    psPrevNode = &psRefs->psHead;
-    do {
-        psCurrNode = (node_s *)( (char *)psPrevNode + psPrevNode->nextDiff );
-        psNextNode = (node_s *)( (char *)psCurrNode + psCurrNode->nextDiff );
-        psTempNode = (node_s *)( (char *)psCurrNode + ( 1 << psCurrNode->shiftDeg ) );
-        psFakeNode = (node_s *)( (char *)psTempNode + ( 1 << shiftDeg ) );
 
-        if ( 0 == psCurrNode->nextDiff )
-        {
-            if ( psRefs->psInfo.psBoundary >= psFakeNode )
-            {
-                // ? this gap is enough
-                psTempNode->headDiff = (char *)psTempNode - (char *)&psRefs->psHead;
-                psCurrNode->nextDiff = (char *)psTempNode - (char *)psCurrNode;
-                psTempNode->nextDiff = 0;
-                psTempNode->shiftDeg = shiftDeg;
-                goto __exit;
-            }
-            else
-            {
-                // ! error: memory not avalible
-                return NULL;
-            }
-        }
-        else if ( psNextNode >= psFakeNode )
-        {
-            // ? this gap is enough
-            psTempNode->headDiff = (char *)psTempNode - (char *)&psRefs->psHead;
-            psCurrNode->nextDiff = (char *)psTempNode - (char *)psCurrNode;
-            psTempNode->nextDiff = (char *)psNextNode - (char *)psTempNode;
-            psTempNode->shiftDeg = shiftDeg;
-            goto __exit;
-        }
+    return ( NULL == _poolLocalOf(psRefs)->psShare ) ?
+        _poolAllocChain(psRefs, shiftDeg) :
+        _poolAllocShared(psRefs, shiftDeg) ;
+}
+
+void *
+poolAllocAligned(
+    pool_s * const psRefs,
+    const size_t zAllocSize,
+    const size_t zAlign
+) {
+    void * pvResult = NULL;
+
+    if ( NULL == psRefs || 0 == zAllocSize || 0 == zAlign || 0 != ( zAlign & ( zAlign - 1 ) ) || POOL_ALIGN_MAX < zAlign )
+    {
+        // ! error: not a supported alignment
+        return NULL;
+    }
+
+    if ( zAlign <= sizeof(node_s) )
+    {
+        return poolAlloc(psRefs, zAllocSize); /* every payload is aligned that far */
+    }
 
-        psPrevNode = psCurrNode;
-        psCurrNode = psNextNode;
-    } while ( true );
+    _poolLock(psRefs);
+    pvResult = _poolAllocAligned(psRefs, zAllocSize, zAlign);
+    _poolUnlock(psRefs);
 
-__exit:
-    psRefs->psInfo.zUsage += ( 1 << psTempNode->shiftDeg );
-    return (void *)( psTempNode + 1 );
+    return pvResult;
 }
 
 pool_s *
@@ -141,54 +542,126 @@ poolErase(
     pool_s * const psRefs,
     void * const pvTarget
 ) {
-    node_s * psPrevNode = NULL;
-    node_s * psCurrNode = NULL;
-    node_s * psNextNode = NULL;
-
     if ( NULL == psRefs || NULL == pvTarget )
     {
         return psRefs;
     }
 
-    if ( 0 == psRefs->psHead.nextDiff )
+    return ( NULL == _poolLocalOf(psRefs)->psShare ) ?
+        _poolEraseChain(psRefs, pvTarget) :
+        _poolEraseShared(psRefs, pvTarget) ;
+}
+
+void *
+poolResize(
+    pool_s * const psRefs,
+    void * const pvTarget,
+    const size_t zSize
+) {
+    pool_s * psRegion = NULL;
+    node_s * psNode = NULL;
+    handle_s * psHandles = NULL;
+    void * pvResult = NULL;
+    size_t zShift = 0;
+    size_t zAlign = 0;
+    pool_handle_t uHandle = 0;
+    unsigned int shiftDeg = 0;
+    unsigned int uOldDeg = 0;
+
+    if ( NULL == psRefs )
     {
-        // ! error: there is no allocated memeory
         return NULL;
     }
 
-    psPrevNode = &psRefs->psHead;
-    psCurrNode = (node_s *)( (char *)psPrevNode + psPrevNode->nextDiff );
-    if ( (void *)psCurrNode > pvTarget || (void *)psRefs->psInfo.psBoundary <= pvTarget )
+    if ( NULL == pvTarget )
     {
-        // ! error: the pointer is not in the valid range
+        return poolAlloc(psRefs, zSize);
+    }
+
+    if ( 0 == zSize )
+    {
+        poolErase(psRefs, pvTarget);
         return NULL;
     }
 
-    while ( (void *)( psCurrNode + 1 ) != pvTarget )
+    _poolLock(psRefs);
+
+    psRegion = _poolRegionOf(psRefs, pvTarget);
+    psNode = _poolSearch(psRegion, pvTarget);
+    if ( NULL == psNode )
     {
-        if ( 0 == psCurrNode->nextDiff )
-        {
-            // ! error not found and no more node
-            return NULL;
-        }
+        // ! error: not an allocated block of this pool
+        _poolUnlock(psRefs);
+        return NULL;
+    }
 
-        psPrevNode = psCurrNode;
-        psCurrNode = (node_s *)( (char *)psPrevNode + psPrevNode->nextDiff );
+    // ? an aligned payload keeps its distance from the header, in place or not
+    zShift = (size_t)( (char *)pvTarget - (char *)( psNode + 1 ) );
+    shiftDeg = ( zSize > POOL_BLOCK(POOL_DEGREE_MAX) - sizeof(node_s) - zShift ) ?
+        ( 0 ) :
+        _poolComputeShiftDegree( sizeof(node_s) + zShift + zSize ) ;
+    if ( 0 == shiftDeg )
+    {
+        // ! error: out of range, larger than the biggest block
+        ++psRefs->psInfo.zFails;
+        _poolUnlock(psRefs);
+        return NULL;
     }
 
-    if ( 0 == psCurrNode->nextDiff )
+    uOldDeg = psNode->shiftDeg;
+    if ( shiftDeg <= uOldDeg )
+    {
+        // ? the block has slack already, give back the halves it does not need
+        _poolShrink(psRegion, psNode, shiftDeg);
+        psRefs->psInfo.zLive -= POOL_BLOCK(uOldDeg) - POOL_BLOCK(shiftDeg);
+        pvResult = pvTarget;
+    }
+    else if ( _poolExtend(psRegion, psNode, shiftDeg) )
     {
-        psPrevNode->nextDiff = 0;
+        psRefs->psInfo.zLive += POOL_BLOCK(shiftDeg) - POOL_BLOCK(uOldDeg);
+        if ( psRefs->psInfo.zPeak < psRefs->psInfo.zLive )
+        {
+            psRefs->psInfo.zPeak = psRefs->psInfo.zLive;
+        }
+        pvResult = pvTarget;
     }
     else
     {
-        psNextNode = (node_s *)( (char *)psCurrNode + psCurrNode->nextDiff );
-        psNextNode->headDiff = (char *)psNextNode - (char *)&psRefs->psHead;
-        psPrevNode->nextDiff = (char *)psNextNode - (char *)psPrevNode;
+        // ? move and copy, the old block is kept if there is no room, the new one is aligned as well as the old one up to POOL_ALIGN_MAX
+        zAlign = (size_t)( (uintptr_t)pvTarget & -(uintptr_t)pvTarget );
+
+        // ? a handle block takes its handle along, it has no shim so poolCompact can slide it
+        psHandles = _poolLocalOf(psRefs)->psHandles;
+        uHandle = psNode->nextDiff;
+        if ( NULL == psHandles || 0 == uHandle || psHandles->uSize < uHandle || (uintptr_t)pvTarget != psHandles->aEntry[ uHandle - 1 ] )
+        {
+            uHandle = 0;
+        }
+
+        if ( 0 != uHandle || zAlign <= sizeof(node_s) )
+        {
+            pvResult = _poolAllocChain(psRefs, shiftDeg);
+        }
+        else
+        {
+            pvResult = _poolAllocAligned(psRefs, zSize, ( zAlign > POOL_ALIGN_MAX ) ? ( POOL_ALIGN_MAX ) : ( zAlign ) );
+        }
+
+        if ( NULL != pvResult )
+        {
+            memcpy(pvResult, pvTarget, POOL_BLOCK(uOldDeg) - sizeof(node_s) - zShift);
+            _poolEraseChain(psRefs, pvTarget);
+
+            if ( 0 != uHandle )
+            {
+                ( (node_s *)pvResult - 1 )->nextDiff = uHandle;
+                psHandles->aEntry[ uHandle - 1 ] = (uintptr_t)pvResult;
+            }
+        }
     }
 
-    psRefs->psInfo.zUsage -= ( 1 << psCurrNode->shiftDeg );
-    return psRefs;
+    _poolUnlock(psRefs);
+    return pvResult;
 }
 
 size_t
@@ -196,44 +669,2716 @@ poolSpace(
     pool_s const * const psRefs,
     void * const pvTarget
 ) {
-    node_s * psCurrNode = NULL;
+    node_s const * psNode = NULL;
 
-    if ( NULL == psRefs || NULL == pvTarget )
+    _poolLock(psRefs);
+    psNode = _poolSearch(_poolRegionOf(psRefs, pvTarget), pvTarget);
+    _poolUnlock(psRefs);
+
+    // ? an aligned payload starts further in, the header in front of it is always counted
+    return ( NULL == psNode ) ?
+        ( 0 ) :
+        ( POOL_BLOCK(psNode->shiftDeg) - (size_t)( (char *)pvTarget - (char *)( psNode + 1 ) ) ) ;
+}
+
+size_t
+poolTotal(
+    pool_s const * const psRefs
+) {
+    pool_s const * psRegion = NULL;
+    size_t zTotal = 0;
+
+    _poolLock(psRefs);
+    for ( psRegion = psRefs; NULL != psRegion; psRegion = psRegion->psInfo.psNext )
     {
-        return psRefs;
+        zTotal += (size_t)( (char *)psRegion->psInfo.psBoundary - (char *)psRegion );
+    }
+    _poolUnlock(psRefs);
+
+    return zTotal;
+}
+
+size_t
+poolUsage(
+    pool_s const * const psRefs
+) {
+    pool_s const * psRegion = NULL;
+    size_t zUsage = 0;
+
+    _poolLock(psRefs);
+    for ( psRegion = psRefs; NULL != psRegion; psRegion = psRegion->psInfo.psNext )
+    {
+        zUsage += psRegion->psInfo.zUsage;
     }
+    _poolUnlock(psRefs);
+
+    return zUsage;
+}
 
-    if ( 0 == psRefs->psHead.nextDiff )
+pool_mode_e
+poolMode(
+    pool_s const * const psRefs
+) {
+    return ( NULL == psRefs ) ? ( PMError ) : ( psRefs->psInfo.eMode ) ;
+}
+
+unsigned int
+poolFragment(
+    pool_s const * const psRefs
+) {
+    pool_s const * psRegion = NULL;
+    size_t zFree = 0;
+    size_t zLargest = 0;
+
+    if ( NULL == psRefs )
     {
-        // ! error: there is no allocated memeory
         return 0;
     }
 
-    psCurrNode = &psRefs->psHead;
-    while ( 0 != psCurrNode->nextDiff )
+    _poolLock(psRefs);
+
+    zFree = poolTotal(psRefs) - poolUsage(psRefs);
+    for ( psRegion = psRefs; NULL != psRegion; psRegion = psRegion->psInfo.psNext )
     {
-        if ( (void *)( psCurrNode + 1 ) == pvTarget )
+        if ( zLargest < _poolLargestFree(psRegion) )
         {
-            // ? found it
-            return ( 1 << psCurrNode->shiftDeg );
+            zLargest = _poolLargestFree(psRegion);
         }
+    }
+
+    _poolUnlock(psRefs);
 
-        psCurrNode = (node_s *)( (char *)psCurrNode + psCurrNode->nextDiff );
+    if ( 0 == zFree )
+    {
+        return 0;
     }
 
-    return 0;
+    // ? share of the free bytes that cannot be handed out as one block, in per-mille
+    return (unsigned int)( 1000 - ( 1000 * zLargest ) / zFree );
 }
 
-size_t
-poolTotal(
-    pool_s const * const psRefs
+pool_s *
+poolReset(
+    pool_s * const psRefs
 ) {
-    return ( NULL == psRefs ) ? ( 0 ) : ( (char *)psRefs->psInfo.psBoundary - (char *)psRefs ) ;
-}
+    pool_s * psRegion = NULL;
 
-size_t
-poolUsage(
-    pool_s const * const psRefs
-) {
-    return ( NULL == psRefs ) ? ( 0 ) : ( psRefs->psInfo.zUsage ) ;
+    if ( NULL == psRefs )
+    {
+        return NULL;
+    }
+
+    _poolLock(psRefs);
+
+    _poolClear(psRefs);
+    _poolLocalOf(psRefs)->psMarkRegion = NULL;
+    psRefs->psInfo.psSlabs = NULL;
+    _poolLocalOf(psRefs)->psSlabMark = NULL;
+    psRefs->psInfo.zLive = 0;
+
+    free(_poolLocalOf(psRefs)->psHandles);
+    _poolLocalOf(psRefs)->psHandles = NULL;
+
+    if ( 0 != ( POOL_FLAG_FILE & psRefs->psInfo.uFlags ) )
+    {
+        _poolFileOf(psRefs)->uRoot = 0;
+    }
+
+    for ( psRegion = psRefs->psInfo.psNext; NULL != psRegion; psRegion = psRegion->psInfo.psNext )
+    {
+        _poolIdle(psRegion);
+    }
+
+    if ( NULL != _poolLocalOf(psRefs)->psShare )
+    {
+        atomic_fetch_add(&_poolLocalOf(psRefs)->psShare->uEpoch, 1);
+    }
+
+    _poolUnlock(psRefs);
+    return psRefs;
+}
+
+pool_s *
+poolMark(
+    pool_s * const psRefs,
+    pool_mark_s * const psMark
+) {
+    pool_s * psRegion = psRefs;
+
+    if ( NULL == psRefs || NULL == psMark )
+    {
+        return NULL;
+    }
+
+    _poolLock(psRefs);
+
+    // ? a parked block would be handed out again after the checkpoint but stay below it
+    if ( NULL != _poolLocalOf(psRefs)->psShare )
+    {
+        _poolCacheFlush(psRefs);
+    }
+
+    // ? the slab state goes in front of the checkpoint, so it outlives it
+    psMark->pvSlabs = NULL;
+    if ( NULL != psRefs->psInfo.psSlabs )
+    {
+        psMark->pvSlabs = _poolMarkSlabs(psRefs);
+        if ( NULL == psMark->pvSlabs )
+        {
+            // ! error: memory not avalible
+            _poolUnlock(psRefs);
+            return NULL;
+        }
+    }
+
+    // ? the checkpoint sits at the frontier of the last region, everything in front of it is frozen
+    while ( NULL != psRegion->psInfo.psNext )
+    {
+        psRegion = psRegion->psInfo.psNext;
+    }
+
+    psMark->psRegion = psRegion;
+    psMark->zFrontier = psRegion->psInfo.zFrontier;
+    psMark->psOuter = _poolLocalOf(psRefs)->psMarkRegion;
+    psMark->zOuter = psRegion->psInfo.zFloor;
+
+    psRegion->psInfo.zFloor = psRegion->psInfo.zFrontier;
+    _poolLocalOf(psRefs)->psMarkRegion = psRegion;
+
+    _poolUnlock(psRefs);
+    return psRefs;
+}
+
+pool_s *
+poolRelease(
+    pool_s * const psRefs,
+    pool_mark_s const * const psMark
+) {
+    pool_s * psRegion = NULL;
+
+    if ( NULL == psRefs || NULL == psMark )
+    {
+        return NULL;
+    }
+
+    _poolLock(psRefs);
+
+    if ( NULL == psMark->psRegion || psMark->psRegion != _poolLocalOf(psRefs)->psMarkRegion || psMark->zFrontier != psMark->psRegion->psInfo.zFloor )
+    {
+        // ! error: not the innermost checkpoint of this pool
+        _poolUnlock(psRefs);
+        return NULL;
+    }
+
+    // ? the caches may hold blocks on both sides of the checkpoint, they go back before the pool is cut
+    if ( NULL != _poolLocalOf(psRefs)->psShare )
+    {
+        _poolCacheFlush(psRefs);
+    }
+
+    // ? regions mapped after the checkpoint only hold blocks made after it
+    for ( psRegion = psMark->psRegion->psInfo.psNext; NULL != psRegion; psRegion = psRegion->psInfo.psNext )
+    {
+        _poolIdle(psRegion);
+    }
+
+    _poolTruncate(psMark->psRegion, psMark->zFrontier);
+    _poolReleaseSlabs(psRefs, psMark);
+    _poolReleaseHandles(psRefs, psMark);
+
+    if ( NULL != poolRoot(psRefs) && _poolDropped(psMark, poolRoot(psRefs)) )
+    {
+        _poolFileOf(psRefs)->uRoot = 0;
+    }
+
+    psRefs->psInfo.zLive = 0;
+    for ( psRegion = psRefs; NULL != psRegion; psRegion = psRegion->psInfo.psNext )
+    {
+        psRefs->psInfo.zLive += psRegion->psInfo.zUsage - POOL_BLOCK(psRegion->psHead.shiftDeg);
+    }
+
+    psMark->psRegion->psInfo.zFloor = psMark->zOuter;
+    _poolLocalOf(psRefs)->psMarkRegion = psMark->psOuter;
+
+    // ? the blocks freed in front of the checkpoint may be out of place or off the lists, the lists are rebuilt for the outer floor
+    if ( 0 != ( POOL_FLAG_SHELF & psMark->psRegion->psInfo.uFlags ) )
+    {
+        _poolMergeRegion(psMark->psRegion);
+    }
+
+    if ( NULL != psMark->pvSlabs )
+    {
+        _poolLocalOf(psRefs)->psSlabMark = ( (slab_mark_s *)psMark->pvSlabs )->psOuter;
+        _poolEraseChain(psRefs, psMark->pvSlabs);
+    }
+
+    _poolUnlock(psRefs);
+    return psRefs;
+}
+
+pool_handle_t
+poolHandleAlloc(
+    pool_s * const psRefs,
+    const size_t zAllocSize
+) {
+    pool_handle_t uHandle = 0;
+    node_s * psNode = NULL;
+    void * pvBlock = NULL;
+    unsigned int shiftDeg = 0;
+
+    if ( NULL == psRefs || 0 == zAllocSize )
+    {
+        return 0;
+    }
+
+    shiftDeg = ( zAllocSize > POOL_BLOCK(POOL_DEGREE_MAX) - sizeof(node_s) ) ?
+        ( 0 ) :
+        _poolComputeShiftDegree( sizeof(node_s) + zAllocSize ) ;
+
+    _poolLock(psRefs);
+
+    if ( 0 == shiftDeg )
+    {
+        // ! error: out of range, larger than the biggest block
+        ++psRefs->psInfo.zFails;
+        _poolUnlock(psRefs);
+        return 0;
+    }
+
+    uHandle = _poolHandleTake(psRefs);
+    if ( 0 == uHandle )
+    {
+        // ! error: memory not avalible
+        ++psRefs->psInfo.zFails;
+        _poolUnlock(psRefs);
+        return 0;
+    }
+
+    pvBlock = _poolAllocChain(psRefs, shiftDeg);
+    if ( NULL == pvBlock )
+    {
+        _poolHandleDrop(psRefs, uHandle);
+        _poolUnlock(psRefs);
+        return 0;
+    }
+
+    psNode = (node_s *)pvBlock - 1;
+    psNode->nextDiff = uHandle;
+    _poolLocalOf(psRefs)->psHandles->aEntry[ uHandle - 1 ] = (uintptr_t)pvBlock;
+
+    _poolUnlock(psRefs);
+    return uHandle;
+}
+
+void *
+poolHandleAccess(
+    pool_s const * const psRefs,
+    const pool_handle_t uHandle
+) {
+    void * pvResult = NULL;
+
+    _poolLock(psRefs);
+    pvResult = _poolHandleOf(psRefs, uHandle);
+    _poolUnlock(psRefs);
+
+    return pvResult;
+}
+
+pool_s *
+poolHandleErase(
+    pool_s * const psRefs,
+    const pool_handle_t uHandle
+) {
+    void * pvBlock = NULL;
+
+    if ( NULL == psRefs || 0 == uHandle )
+    {
+        return psRefs;
+    }
+
+    _poolLock(psRefs);
+
+    pvBlock = _poolHandleOf(psRefs, uHandle);
+    if ( NULL == pvBlock )
+    {
+        // ! error: not a handle of this pool
+        _poolUnlock(psRefs);
+        return NULL;
+    }
+
+    _poolEraseChain(psRefs, pvBlock);
+    _poolHandleDrop(psRefs, uHandle);
+
+    _poolUnlock(psRefs);
+    return psRefs;
+}
+
+pool_s *
+poolCompact(
+    pool_s * const psRefs
+) {
+    pool_s * psRegion = NULL;
+
+    if ( NULL == psRefs )
+    {
+        return NULL;
+    }
+
+    _poolLock(psRefs);
+
+    // ? buddy blocks are pinned by their alignment, and a checkpoint freezes the blocks in front of it
+    if ( PMSegregate != psRefs->psInfo.eMode || NULL != _poolLocalOf(psRefs)->psMarkRegion )
+    {
+        _poolUnlock(psRefs);
+        return NULL;
+    }
+
+    for ( psRegion = psRefs; NULL != psRegion; psRegion = psRegion->psInfo.psNext )
+    {
+        _poolCompactRegion(psRefs, psRegion);
+    }
+
+    _poolUnlock(psRefs);
+    return psRefs;
+}
+
+pool_stats_s *
+poolStats(
+    pool_s const * const psRefs,
+    pool_stats_s * const psStats
+) {
+    pool_s const * psRegion = NULL;
+    size_t zLargest = 0;
+    unsigned int idx = 0;
+
+    if ( NULL == psRefs || NULL == psStats )
+    {
+        return NULL;
+    }
+
+    _poolLock(psRefs);
+
+    psStats->zTotal = poolTotal(psRefs);
+    psStats->zUsage = poolUsage(psRefs);
+    psStats->zLive = psRefs->psInfo.zLive;
+    psStats->zPeak = psRefs->psInfo.zPeak;
+    psStats->zAllocs = psRefs->psInfo.zAllocs;
+    psStats->zErases = psRefs->psInfo.zErases;
+    psStats->zFails = psRefs->psInfo.zFails;
+    psStats->zLargest = 0;
+    psStats->uRegions = 0;
+    psStats->uFragment = poolFragment(psRefs);
+
+    for ( idx = 0; idx < POOL_STATS_DEGREE_NUM; ++idx )
+    {
+        psStats->azUsed[ idx ] = psStats->azFree[ idx ] = 0;
+    }
+
+    // ? the counters are kept on every call, only the histograms walk the blocks
+    for ( psRegion = psRefs; NULL != psRegion; psRegion = psRegion->psInfo.psNext )
+    {
+        zLargest = _poolLargestFree(psRegion);
+        if ( psStats->zLargest < zLargest )
+        {
+            psStats->zLargest = zLargest;
+        }
+
+        _poolCount(psRegion, psStats->azUsed, psStats->azFree);
+        ++psStats->uRegions;
+    }
+
+    _poolUnlock(psRefs);
+    return psStats;
+}
+
+void
+poolDump(
+    pool_s const * const psRefs,
+    FILE * const psFile
+) {
+    pool_s const * psRegion = NULL;
+    node_s const * psNode = NULL;
+    size_t zOffset = 0;
+    size_t zTail = 0;
+
+    if ( NULL == psRefs || NULL == psFile )
+    {
+        return;
+    }
+
+    _poolLock(psRefs);
+
+    for ( psRegion = psRefs; NULL != psRegion; psRegion = psRegion->psInfo.psNext )
+    {
+        zTail = (size_t)( (char *)psRegion->psInfo.psBoundary - (char *)psRegion );
+        fprintf(psFile, "region %p: total %zu, usage %zu, frontier %zu, floor %zu\n",
+            (void *)psRegion, zTail, psRegion->psInfo.zUsage, psRegion->psInfo.zFrontier, psRegion->psInfo.zFloor);
+
+        // ? the blocks tile the region, so each header leads to the next one
+        for ( zOffset = POOL_BLOCK(psRegion->psHead.shiftDeg); zOffset < psRegion->psInfo.zFrontier; zOffset += POOL_BLOCK(psNode->shiftDeg) )
+        {
+            psNode = _poolNodeAt(psRegion, zOffset);
+            fprintf(psFile, "  %10zu %10zu %s\n", zOffset, POOL_BLOCK(psNode->shiftDeg), ( 0 != psNode->headDiff ) ? ( "used" ) : ( "free" ));
+        }
+
+        if ( psRegion->psInfo.zFrontier < zTail )
+        {
+            fprintf(psFile, "  %10zu %10zu untouched\n", psRegion->psInfo.zFrontier, zTail - psRegion->psInfo.zFrontier);
+        }
+    }
+
+    _poolUnlock(psRefs);
+}
+
+slab_s *
+slabMake(
+    pool_s * const psPool,
+    const size_t zObjSize
+) {
+    const size_t zSize = SLAB_ALIGN( ( 0 == zObjSize ) ? ( 1 ) : ( zObjSize ) );
+    slab_s * psRefs = NULL;
+
+    if ( NULL == psPool || zObjSize > SLAB_OBJECT_MAX )
+    {
+        return NULL;
+    }
+
+    _poolLock(psPool);
+
+    // ? one slab per object size and pool, so small containers do not hold a page each
+    for ( psRefs = psPool->psInfo.psSlabs; NULL != psRefs; psRefs = psRefs->psNext )
+    {
+        if ( zSize == psRefs->zSize )
+        {
+            ++psRefs->zRefs;
+            _poolUnlock(psPool);
+            return psRefs;
+        }
+    }
+
+    psRefs = (slab_s *)_poolAllocChain(psPool, _poolComputeShiftDegree( sizeof(node_s) + sizeof(slab_s) ));
+    if ( NULL != psRefs )
+    {
+        psRefs->psPool = psPool;
+        psRefs->psNext = psPool->psInfo.psSlabs;
+        psRefs->zSize = zSize;
+        psRefs->zRefs = 1;
+        psRefs->pvPages = psRefs->pvFree = NULL;
+        psRefs->pCarve = psRefs->pCarveEnd = NULL;
+        psRefs->apIndex = NULL;
+        psRefs->zIndex = 0;
+        psRefs->pLastPage = NULL;
+
+        psPool->psInfo.psSlabs = psRefs;
+    }
+
+    _poolUnlock(psPool);
+    return psRefs;
+}
+
+void
+slabFree(
+    void * pvRefs
+) {
+    slab_s * const psRefs = (slab_s *)( pvRefs );
+    pool_s * psPool = NULL;
+    slab_s ** ppsLink = NULL;
+    slab_mark_s * psMark = NULL;
+    void * pvPage = NULL;
+    size_t idx = 0;
+
+    if ( NULL == psRefs )
+    {
+        return;
+    }
+
+    psPool = psRefs->psPool;
+    _poolLock(psPool);
+
+    if ( 0 == --psRefs->zRefs )
+    {
+        for ( ppsLink = &psPool->psInfo.psSlabs; psRefs != *ppsLink; ppsLink = &( *ppsLink )->psNext ) { }
+        *ppsLink = psRefs->psNext;
+
+        // ? the checkpoints must not bring it back, its block may hold another slab by then
+        for ( psMark = _poolLocalOf(psPool)->psSlabMark; NULL != psMark; psMark = psMark->psOuter )
+        {
+            for ( idx = 0; idx < psMark->zCount; ++idx )
+            {
+                if ( psRefs == psMark->asSlab[ idx ].psSlab )
+                {
+                    psMark->asSlab[ idx ].psSlab = NULL;
+                }
+            }
+        }
+
+        if ( NULL != psRefs->apIndex )
+        {
+            _poolEraseChain(psPool, psRefs->apIndex);
+        }
+
+        while ( NULL != psRefs->pvPages )
+        {
+            pvPage = psRefs->pvPages;
+            psRefs->pvPages = *(void **)pvPage;
+            _poolEraseChain(psPool, pvPage);
+        }
+
+        _poolEraseChain(psPool, psRefs);
+    }
+
+    _poolUnlock(psPool);
+}
+
+void *
+slabAlloc(
+    slab_s * const psRefs
+) {
+    void * pvResult = NULL;
+    char * pPage = NULL;
+
+    if ( NULL == psRefs )
+    {
+        return NULL;
+    }
+
+    _poolLock(psRefs->psPool);
+
+    if ( NULL != psRefs->pvFree )
+    {
+        pvResult = psRefs->pvFree;
+        psRefs->pvFree = *(void **)pvResult;
+    }
+    else
+    {
+        if ( psRefs->pCarve + psRefs->zSize > psRefs->pCarveEnd )
+        {
+            pPage = (char *)_poolAllocChain(psRefs->psPool, SLAB_PAGE_DEGREE);
+            if ( NULL == pPage )
+            {
+                // ! error: memory not avalible
+                _poolUnlock(psRefs->psPool);
+                return NULL;
+            }
+
+            // ? the link takes the first word, so the objects start 16 bytes aligned
+            *(void **)pPage = psRefs->pvPages;
+            psRefs->pvPages = pPage;
+            _poolSlabInsert(psRefs, pPage);
+            psRefs->pCarve = pPage + sizeof(void *);
+            psRefs->pCarveEnd = pPage + POOL_BLOCK(SLAB_PAGE_DEGREE) - sizeof(node_s);
+        }
+
+        pvResult = psRefs->pCarve;
+        psRefs->pCarve += psRefs->zSize;
+    }
+
+    _poolUnlock(psRefs->psPool);
+    return pvResult;
+}
+
+slab_s *
+slabErase(
+    slab_s * const psRefs,
+    void * const pvTarget
+) {
+#ifndef NDEBUG
+    void const * pvLink = NULL;
+#endif /* NDEBUG */
+
+    if ( NULL == psRefs || NULL == pvTarget )
+    {
+        return psRefs;
+    }
+
+    _poolLock(psRefs->psPool);
+
+    if ( false == _poolSlabOwns(psRefs, pvTarget) )
+    {
+        // ! error: not an object handed out by this slab
+        _poolUnlock(psRefs->psPool);
+        return NULL;
+    }
+
+#ifndef NDEBUG
+    // ? a second erase would link the object to itself, the whole free list is walked in debug builds only
+    for ( pvLink = psRefs->pvFree; NULL != pvLink; pvLink = *(void * const *)pvLink )
+    {
+        if ( pvTarget == pvLink )
+        {
+            // ! error: the object is free already
+            _poolUnlock(psRefs->psPool);
+            return NULL;
+        }
+    }
+#endif /* NDEBUG */
+
+    *(void **)pvTarget = psRefs->pvFree;
+    psRefs->pvFree = pvTarget;
+    _poolUnlock(psRefs->psPool);
+
+    return psRefs;
+}
+
+size_t
+slabSize(
+    slab_s const * const psRefs
+) {
+    return ( NULL == psRefs ) ? ( 0 ) : ( psRefs->zSize ) ;
+}
+
+/* private */
+static
+unsigned int
+_poolComputeShiftDegree(
+    const size_t zSize
+) {
+    unsigned int deg;
+
+    /* check degree [4, 30], if less than 16 bytes, then assign 16 bytes = ( 1 << 4 ) */
+    for ( deg = POOL_DEGREE_MIN; POOL_BLOCK(deg) < zSize; ++deg )
+    {
+        if ( deg >= POOL_DEGREE_MAX )
+        {
+            // ! error: too large
+            return 0;
+        }
+    }
+
+    return deg;
+}
+
+static
+void
+_poolClear(
+    pool_s * const psRefs
+) {
+    unsigned int idx = 0;
+
+    psRefs->psInfo.zFrontier = POOL_BLOCK(psRefs->psHead.shiftDeg);
+    psRefs->psInfo.zFloor = 0;
+    psRefs->psInfo.zUsage = POOL_BLOCK(psRefs->psHead.shiftDeg);
+    psRefs->psInfo.uFlags &= ~( POOL_FLAG_LOOSE | POOL_FLAG_SHELF );
+
+    for ( idx = 0; idx < POOL_DEGREE_NUM; ++idx )
+    {
+        psRefs->psInfo.aFreeList[ idx ] = 0;
+    }
+    psRefs->psInfo.uFreeMap = 0;
+}
+
+static
+void *
+_poolAllocRegion(
+    pool_s * const psRefs,
+    const unsigned int shiftDeg
+) {
+    node_s * psNode = NULL;
+
+    // ? reuse a free block first, keep the untouched tail for the larger requests
+    psNode = _poolTakeFree(psRefs, shiftDeg);
+    if ( NULL == psNode )
+    {
+        psNode = ( PMBuddy == psRefs->psInfo.eMode ) ?
+            _poolTakeBuddyFrontier(psRefs, shiftDeg) :
+            _poolTakeFrontier(psRefs, shiftDeg) ;
+    }
+
+    // ? the erased blocks are merged only once they are needed, so poolErase stays constant time
+    if ( NULL == psNode && 0 != ( POOL_FLAG_LOOSE & psRefs->psInfo.uFlags ) )
+    {
+        _poolMergeRegion(psRefs);
+
+        psNode = _poolTakeFree(psRefs, shiftDeg);
+        if ( NULL == psNode )
+        {
+            psNode = _poolTakeFrontier(psRefs, shiftDeg);
+        }
+    }
+
+    if ( NULL == psNode )
+    {
+        return NULL;
+    }
+
+    psNode->headDiff = POOL_GRAIN( _poolOffsetOf(psRefs, psNode) );
+    psNode->nextDiff = 0;
+    psNode->shiftDeg = shiftDeg;
+
+    psRefs->psInfo.zUsage += POOL_BLOCK(shiftDeg);
+    return (void *)( psNode + 1 );
+}
+
+static
+pool_s *
+_poolEraseRegion(
+    pool_s * const psRefs,
+    node_s * psNode
+) {
+    size_t zOffset = 0;
+
+    psRefs->psInfo.zUsage -= POOL_BLOCK(psNode->shiftDeg);
+    psNode->headDiff = 0; /* a merged or retreated header must not look allocated later */
+
+    if ( PMBuddy == psRefs->psInfo.eMode )
+    {
+        psNode = _poolMergeBuddy(psRefs, psNode);
+    }
+
+    zOffset = _poolOffsetOf(psRefs, psNode);
+    if ( zOffset + POOL_BLOCK(psNode->shiftDeg) == psRefs->psInfo.zFrontier && zOffset >= psRefs->psInfo.zFloor )
+    {
+        // ? the last block goes back to the untouched tail
+        psRefs->psInfo.zFrontier = zOffset;
+
+        if ( PMBuddy == psRefs->psInfo.eMode )
+        {
+            _poolTrimBuddy(psRefs);
+        }
+    }
+    else
+    {
+        _poolPushFree(psRefs, psNode, psNode->shiftDeg);
+
+        if ( PMSegregate == psRefs->psInfo.eMode )
+        {
+            psRefs->psInfo.uFlags |= POOL_FLAG_LOOSE;
+        }
+    }
+
+    return psRefs;
+}
+
+static
+pool_s *
+_poolRegionOf(
+    pool_s const * const psRefs,
+    void const * const pvTarget
+) {
+    pool_s const * psRegion = NULL;
+
+    for ( psRegion = psRefs; NULL != psRegion; psRegion = psRegion->psInfo.psNext )
+    {
+        if ( (void const *)psRegion < pvTarget && pvTarget < (void const *)psRegion->psInfo.psBoundary )
+        {
+            return (pool_s *)psRegion;
+        }
+    }
+
+    return NULL;
+}
+
+static
+pool_s *
+_poolMapRegion(
+    const size_t zSize,
+    const pool_mode_e eMode,
+    const unsigned int uFlags
+) {
+    const size_t zPage = (size_t)sysconf(_SC_PAGESIZE);
+    const size_t zLength = ( zSize + zPage - 1 ) & ~( zPage - 1 );
+    pool_s * psRegion = NULL;
+    void * pvBuffer = NULL;
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+
+#ifdef MAP_POPULATE
+    if ( 0 != ( PFPopulate & uFlags ) )
+    {
+        flags |= MAP_POPULATE;
+    }
+#endif /* MAP_POPULATE */
+
+    pvBuffer = mmap(NULL, zLength, PROT_READ | PROT_WRITE, flags, -1, 0);
+    if ( MAP_FAILED == pvBuffer )
+    {
+        return NULL;
+    }
+
+#ifdef MADV_HUGEPAGE
+    if ( 0 != ( PFHugePage & uFlags ) )
+    {
+        madvise(pvBuffer, zLength, MADV_HUGEPAGE); /* only a hint, a failure is harmless */
+    }
+#endif /* MADV_HUGEPAGE */
+
+    psRegion = poolFormatMode(pvBuffer, zLength, eMode);
+    if ( NULL == psRegion || zLength != poolTotal(psRegion) )
+    {
+        munmap(pvBuffer, zLength);
+        return NULL;
+    }
+
+    psRegion->psInfo.uFlags = uFlags;
+    return psRegion;
+}
+
+static
+pool_s *
+_poolGrow(
+    pool_s * const psRefs,
+    const unsigned int shiftDeg
+) {
+    pool_s * psTail = psRefs;
+    pool_s * psRegion = NULL;
+    size_t zSize = psRefs->psInfo.zRegion;
+
+    if ( 0 == psRefs->psInfo.zRegion )
+    {
+        return NULL; /* a formatted pool is limited to its buffer */
+    }
+
+    // ? the first block starts right after the header and is aligned from there, so this fits both modes
+    if ( zSize < POOL_BLOCK(psRefs->psHead.shiftDeg) + POOL_BLOCK(shiftDeg) )
+    {
+        zSize = POOL_BLOCK(psRefs->psHead.shiftDeg) + POOL_BLOCK(shiftDeg);
+    }
+
+    psRegion = _poolMapRegion(zSize, psRefs->psInfo.eMode, psRefs->psInfo.uFlags & ~( POOL_FLAG_LOOSE | POOL_FLAG_SHELF ));
+    if ( NULL == psRegion )
+    {
+        return NULL;
+    }
+
+    while ( NULL != psTail->psInfo.psNext )
+    {
+        psTail = psTail->psInfo.psNext;
+    }
+    psTail->psInfo.psNext = psRegion;
+
+    // ? double the next region, so the chain walked by poolAlloc and poolErase stays short
+    if ( psRefs->psInfo.zRegion <= POOL_SPAN_MAX / 2 )
+    {
+        psRefs->psInfo.zRegion *= 2;
+    }
+
+    return psRegion;
+}
+
+static
+void
+_poolIdle(
+    pool_s * const psRefs
+) {
+    const size_t zPage = (size_t)sysconf(_SC_PAGESIZE);
+    char * const pBegin = (char *)psRefs + ( ( POOL_BLOCK(psRefs->psHead.shiftDeg) + zPage - 1 ) & ~( zPage - 1 ) );
+    char * const pEnd = (char *)psRefs->psInfo.psBoundary;
+
+    _poolClear(psRefs);
+
+    if ( pBegin < pEnd )
+    {
+        madvise(pBegin, (size_t)( pEnd - pBegin ), MADV_DONTNEED);
+    }
+}
+
+static
+void
+_poolTruncate(
+    pool_s * const psRefs,
+    const size_t zFrontier
+) {
+    node_s * psNode = NULL;
+    size_t zFree = 0;
+    uint32_t uNext = 0;
+    unsigned int idx = 0;
+
+    // ? drop the free blocks beyond the new frontier, they are counted as released bytes already
+    for ( idx = 0; idx < POOL_DEGREE_NUM; ++idx )
+    {
+        for ( uNext = psRefs->psInfo.aFreeList[ idx ]; 0 != uNext; )
+        {
+            psNode = _poolNodeAt(psRefs, POOL_BYTES(uNext));
+            uNext = psNode->nextDiff;
+
+            if ( _poolOffsetOf(psRefs, psNode) >= zFrontier )
+            {
+                zFree += POOL_BLOCK(psNode->shiftDeg);
+                _poolDropFree(psRefs, psNode);
+            }
+        }
+    }
+
+    psRefs->psInfo.zUsage -= ( psRefs->psInfo.zFrontier - zFrontier ) - zFree;
+    psRefs->psInfo.zFrontier = zFrontier;
+}
+
+static
+node_s *
+_poolNodeAt(
+    pool_s const * const psRefs,
+    const size_t zOffset
+) {
+    return (node_s *)( (char *)&psRefs->psHead + zOffset );
+}
+
+static
+size_t
+_poolOffsetOf(
+    pool_s const * const psRefs,
+    node_s const * const psNode
+) {
+    return (size_t)( (char const *)psNode - (char const *)&psRefs->psHead );
+}
+
+static
+node_s *
+_poolSearch(
+    pool_s const * const psRefs,
+    void const * const pvTarget
+) {
+    node_s * psNode = NULL;
+    node_s const * psShim = NULL;
+    size_t zOffset = 0;
+
+    if ( NULL == psRefs || NULL == pvTarget )
+    {
+        return NULL;
+    }
+
+    // ? the header sits right in front of the payload
+    psNode = (node_s *)pvTarget - 1;
+    if ( (char const *)psNode < (char const *)_poolNodeAt(psRefs, POOL_BLOCK(psRefs->psHead.shiftDeg)) )
+    {
+        // ! error: the pointer is not in the valid range
+        return NULL;
+    }
+
+    // ? an aligned payload is preceded by a shim, which leads back to the header of its block
+    if ( 0 == psNode->shiftDeg )
+    {
+        psShim = psNode;
+        psNode = (node_s *)( (char const *)pvTarget - psShim->nextDiff ) - 1;
+        if ( (char const *)psNode < (char const *)_poolNodeAt(psRefs, POOL_BLOCK(psRefs->psHead.shiftDeg)) || psShim->headDiff != psNode->headDiff )
+        {
+            // ! error: the pointer is not in the valid range
+            return NULL;
+        }
+
+        if ( POOL_DEGREE_MIN > psNode->shiftDeg || psShim->nextDiff + sizeof(node_s) >= POOL_BLOCK(psNode->shiftDeg) )
+        {
+            // ! error: the shim does not lie in its block
+            return NULL;
+        }
+    }
+
+    zOffset = _poolOffsetOf(psRefs, psNode);
+    if ( zOffset >= psRefs->psInfo.zFrontier || 0 != ( zOffset & ( POOL_BLOCK(POOL_DEGREE_MIN) - 1 ) ) )
+    {
+        // ! error: the pointer is not in the valid range
+        return NULL;
+    }
+
+    // ? an allocated block anchors itself, a free block or a foreign pointer does not
+    return ( POOL_GRAIN(zOffset) == psNode->headDiff ) ? ( psNode ) : ( NULL ) ;
+}
+
+static
+void
+_poolPushFree(
+    pool_s * const psRefs,
+    node_s * const psNode,
+    const unsigned int shiftDeg
+) {
+    const unsigned int idx = shiftDeg - POOL_DEGREE_MIN;
+    const uint32_t uHead = psRefs->psInfo.aFreeList[ idx ];
+
+    psNode->headDiff = 0;
+    psNode->nextDiff = uHead;
+    psNode->shiftDeg = shiftDeg;
+    *_poolPrevFree(psNode) = 0;
+
+    // ? a block in front of the checkpoint must not hide the usable ones behind it
+    if ( _poolOffsetOf(psRefs, psNode) < psRefs->psInfo.zFloor )
+    {
+        psRefs->psInfo.uFlags |= POOL_FLAG_SHELF;
+        if ( 0 != uHead && POOL_BYTES(uHead) >= psRefs->psInfo.zFloor )
+        {
+            psNode->nextDiff = 0;
+            return;
+        }
+    }
+
+    if ( 0 != psNode->nextDiff )
+    {
+        *_poolPrevFree(_poolNodeAt(psRefs, POOL_BYTES(psNode->nextDiff))) = POOL_GRAIN( _poolOffsetOf(psRefs, psNode) );
+    }
+
+    psRefs->psInfo.aFreeList[ idx ] = POOL_GRAIN( _poolOffsetOf(psRefs, psNode) );
+    psRefs->psInfo.uFreeMap |= ( (uint32_t)1 << idx );
+}
+
+static
+node_s *
+_poolPopFree(
+    pool_s * const psRefs,
+    const unsigned int shiftDeg
+) {
+    node_s * const psNode = _poolNodeAt(psRefs, POOL_BYTES(psRefs->psInfo.aFreeList[ shiftDeg - POOL_DEGREE_MIN ]));
+
+    _poolDropFree(psRefs, psNode);
+    return psNode;
+}
+
+static
+void
+_poolDropFree(
+    pool_s * const psRefs,
+    node_s * const psNode
+) {
+    const unsigned int idx = psNode->shiftDeg - POOL_DEGREE_MIN;
+    const uint32_t uPrev = *_poolPrevFree(psNode);
+
+    if ( 0 == uPrev )
+    {
+        psRefs->psInfo.aFreeList[ idx ] = psNode->nextDiff;
+    }
+    else
+    {
+        _poolNodeAt(psRefs, POOL_BYTES(uPrev))->nextDiff = psNode->nextDiff;
+    }
+
+    if ( 0 != psNode->nextDiff )
+    {
+        *_poolPrevFree(_poolNodeAt(psRefs, POOL_BYTES(psNode->nextDiff))) = uPrev;
+    }
+
+    if ( 0 == psRefs->psInfo.aFreeList[ idx ] )
+    {
+        psRefs->psInfo.uFreeMap &= ~( (uint32_t)1 << idx );
+    }
+}
+
+static
+uint32_t *
+_poolPrevFree(
+    node_s * const psNode
+) {
+    return (uint32_t *)( psNode + 1 );
+}
+
+static
+node_s *
+_poolTakeFree(
+    pool_s * const psRefs,
+    const unsigned int shiftDeg
+) {
+    node_s * psNode = NULL;
+    uint32_t uMap = 0;
+    unsigned int deg = 0;
+
+    // ? the smallest non-empty degree which is not less than the request, and not in front of a checkpoint
+    for ( uMap = psRefs->psInfo.uFreeMap >> ( shiftDeg - POOL_DEGREE_MIN ); 0 != uMap; uMap &= ( uMap - 1 ) )
+    {
+        deg = shiftDeg + __builtin_ctz(uMap);
+        if ( POOL_BYTES(psRefs->psInfo.aFreeList[ deg - POOL_DEGREE_MIN ]) >= psRefs->psInfo.zFloor )
+        {
+            break;
+        }
+    }
+
+    if ( 0 == uMap )
+    {
+        return NULL;
+    }
+
+    psNode = _poolPopFree(psRefs, deg);
+
+    // ? split the larger block: keep the head, release [ 2^shiftDeg, 2^(shiftDeg+1), ..., 2^(deg-1) ]
+    while ( deg > shiftDeg )
+    {
+        --deg;
+        _poolPushFree(psRefs, (node_s *)( (char *)psNode + POOL_BLOCK(deg) ), deg);
+    }
+
+    return psNode;
+}
+
+static
+node_s *
+_poolTakeFrontier(
+    pool_s * const psRefs,
+    const unsigned int shiftDeg
+) {
+    node_s * const psNode = _poolNodeAt(psRefs, psRefs->psInfo.zFrontier);
+
+    if ( POOL_BLOCK(shiftDeg) > (size_t)( (char *)psRefs->psInfo.psBoundary - (char *)psNode ) )
+    {
+        return NULL;
+    }
+
+    psRefs->psInfo.zFrontier += POOL_BLOCK(shiftDeg);
+    return psNode;
+}
+
+static
+node_s *
+_poolTakeBuddyFrontier(
+    pool_s * const psRefs,
+    const unsigned int shiftDeg
+) {
+    const size_t zBase = POOL_BLOCK(psRefs->psHead.shiftDeg);
+    const size_t zTail = (char *)psRefs->psInfo.psBoundary - (char *)&psRefs->psHead;
+    size_t zCurr = psRefs->psInfo.zFrontier - zBase;
+    size_t zAlign = 0;
+    unsigned int deg = 0;
+
+    // ? a buddy block must start at a multiple of its own size
+    zAlign = ( zCurr + POOL_BLOCK(shiftDeg) - 1 ) & ~( POOL_BLOCK(shiftDeg) - 1 );
+    if ( zBase + zAlign + POOL_BLOCK(shiftDeg) > zTail )
+    {
+        return NULL;
+    }
+
+    // ? cover the skipped gap with the largest aligned free blocks
+    while ( zCurr < zAlign )
+    {
+        for ( deg = __builtin_ctzl(zCurr); zCurr + POOL_BLOCK(deg) > zAlign; --deg ) { }
+        _poolPushFree(psRefs, _poolNodeAt(psRefs, zBase + zCurr), deg);
+        zCurr += POOL_BLOCK(deg);
+    }
+
+    psRefs->psInfo.zFrontier = zBase + zAlign + POOL_BLOCK(shiftDeg);
+    return _poolNodeAt(psRefs, zBase + zAlign);
+}
+
+static
+node_s *
+_poolMergeBuddy(
+    pool_s * const psRefs,
+    node_s * psNode
+) {
+    const size_t zBase = POOL_BLOCK(psRefs->psHead.shiftDeg);
+    size_t zCurr = _poolOffsetOf(psRefs, psNode) - zBase;
+    size_t zPeer = 0;
+    size_t zJoin = 0;
+    node_s * psPeer = NULL;
+    unsigned int deg = psNode->shiftDeg;
+
+    while ( deg < POOL_DEGREE_MAX )
+    {
+        zPeer = zCurr ^ POOL_BLOCK(deg);
+        if ( zBase + zPeer + POOL_BLOCK(deg) > psRefs->psInfo.zFrontier )
+        {
+            break; /* the buddy has not been handed out yet */
+        }
+
+        // ? a merged block must not straddle an active checkpoint
+        zJoin = zBase + ( zCurr & ~POOL_BLOCK(deg) );
+        if ( zJoin < psRefs->psInfo.zFloor && psRefs->psInfo.zFloor < zJoin + POOL_BLOCK(deg + 1) )
+        {
+            break;
+        }
+
+        // ? merge only with a whole free buddy, a split one starts with a smaller degree
+        psPeer = _poolNodeAt(psRefs, zBase + zPeer);
+        if ( 0 != psPeer->headDiff || deg != psPeer->shiftDeg || !_poolListed(psRefs, psPeer) )
+        {
+            break; /* a block left off the lists waits for the release */
+        }
+
+        _poolDropFree(psRefs, psPeer);
+        zCurr &= ~POOL_BLOCK(deg);
+        ++deg;
+    }
+
+    psNode = _poolNodeAt(psRefs, zBase + zCurr);
+    psNode->shiftDeg = deg;
+    return psNode;
+}
+
+static
+void
+_poolMergeRegion(
+    pool_s * const psRefs
+) {
+    node_s * psNode = NULL;
+    size_t zOffset = POOL_BLOCK(psRefs->psHead.shiftDeg);
+    size_t zBegin = zOffset;
+    size_t zSize = 0;
+    unsigned int idx = 0;
+
+    // ? the free lists are rebuilt from the runs of free blocks, a run stops at the floor of a checkpoint
+    for ( idx = 0; idx < POOL_DEGREE_NUM; ++idx )
+    {
+        psRefs->psInfo.aFreeList[ idx ] = 0;
+    }
+    psRefs->psInfo.uFreeMap = 0;
+
+    // ? the lists are pushed from the lowest offset up, so every list is ordered from the highest one whatever the floor
+    // ? a run left in front of the floor flags the region again, so the release merges it over the floor
+    psRefs->psInfo.uFlags &= ~( POOL_FLAG_LOOSE | POOL_FLAG_SHELF );
+
+    for ( ; zOffset < psRefs->psInfo.zFrontier; zOffset += zSize )
+    {
+        psNode = _poolNodeAt(psRefs, zOffset);
+        zSize = POOL_BLOCK(psNode->shiftDeg);
+
+        if ( zOffset == psRefs->psInfo.zFloor )
+        {
+            zBegin = _poolPushGap(psRefs, zBegin, zOffset);
+        }
+
+        if ( 0 != psNode->headDiff )
+        {
+            zBegin = _poolPushGap(psRefs, zBegin, zOffset) + zSize;
+        }
+    }
+
+    // ? the last run goes back to the untouched tail
+    if ( zBegin >= psRefs->psInfo.zFloor )
+    {
+        psRefs->psInfo.zFrontier = zBegin;
+    }
+    else
+    {
+        _poolPushGap(psRefs, zBegin, psRefs->psInfo.zFrontier);
+    }
+}
+
+static
+void
+_poolTrimBuddy(
+    pool_s * const psRefs
+) {
+    const size_t zBase = POOL_BLOCK(psRefs->psHead.shiftDeg);
+    node_s * psLast = NULL;
+    unsigned int deg = 0;
+
+    while ( psRefs->psInfo.zFrontier > zBase && psRefs->psInfo.zFrontier > psRefs->psInfo.zFloor )
+    {
+        // ? the last block is aligned to its size, so try the widest aligned start below the frontier first
+        // ? stale headers and payload bytes may match the degree as well, so a free block must be listed
+        deg = __builtin_ctzl(psRefs->psInfo.zFrontier - zBase);
+        for ( deg = ( deg > POOL_DEGREE_MAX ) ? ( POOL_DEGREE_MAX ) : ( deg ) ; deg >= POOL_DEGREE_MIN; --deg )
+        {
+            psLast = _poolNodeAt(psRefs, psRefs->psInfo.zFrontier - POOL_BLOCK(deg));
+            if ( deg == psLast->shiftDeg && ( POOL_GRAIN( _poolOffsetOf(psRefs, psLast) ) == psLast->headDiff || _poolListed(psRefs, psLast) ) )
+            {
+                break;
+            }
+        }
+
+        if ( deg < POOL_DEGREE_MIN || 0 != psLast->headDiff )
+        {
+            break; /* still in use */
+        }
+
+        _poolDropFree(psRefs, psLast);
+        psRefs->psInfo.zFrontier -= POOL_BLOCK(deg);
+    }
+}
+
+static
+bool
+_poolListed(
+    pool_s const * const psRefs,
+    node_s * const psNode
+) {
+    const uint32_t uSelf = POOL_GRAIN( _poolOffsetOf(psRefs, psNode) );
+    const uint32_t uPrev = *_poolPrevFree(psNode);
+
+    if ( 0 != psNode->headDiff || POOL_DEGREE_MIN > psNode->shiftDeg || POOL_DEGREE_MAX < psNode->shiftDeg )
+    {
+        return false;
+    }
+
+    // ? a free block is linked from its predecessor, or heads its list
+    if ( 0 == uPrev )
+    {
+        return uSelf == psRefs->psInfo.aFreeList[ psNode->shiftDeg - POOL_DEGREE_MIN ];
+    }
+
+    return POOL_BYTES(uPrev) < psRefs->psInfo.zFrontier && uSelf == _poolNodeAt(psRefs, POOL_BYTES(uPrev))->nextDiff;
+}
+
+static
+size_t
+_poolLargestFree(
+    pool_s const * const psRefs
+) {
+    const size_t zBase = POOL_BLOCK(psRefs->psHead.shiftDeg);
+    const size_t zTail = (char *)psRefs->psInfo.psBoundary - (char *)&psRefs->psHead;
+    size_t zAlign = 0;
+    unsigned int deg = 0;
+
+    for ( deg = POOL_DEGREE_MAX; deg >= POOL_DEGREE_MIN; --deg )
+    {
+        if ( 0 != ( psRefs->psInfo.uFreeMap & ( (uint32_t)1 << ( deg - POOL_DEGREE_MIN ) ) ) )
+        {
+            return POOL_BLOCK(deg);
+        }
+
+        zAlign = psRefs->psInfo.zFrontier;
+        if ( PMBuddy == psRefs->psInfo.eMode )
+        {
+            zAlign = zBase + ( ( zAlign - zBase + POOL_BLOCK(deg) - 1 ) & ~( POOL_BLOCK(deg) - 1 ) );
+        }
+
+        if ( zAlign + POOL_BLOCK(deg) <= zTail )
+        {
+            return POOL_BLOCK(deg);
+        }
+    }
+
+    return 0;
+}
+
+static
+void *
+_poolAllocChain(
+    pool_s * const psRefs,
+    const unsigned int shiftDeg
+) {
+    pool_s * psRegion = NULL;
+    void * pvResult = NULL;
+
+    // ? allocations made under a checkpoint never land in front of it
+    psRegion = ( NULL == _poolLocalOf(psRefs)->psMarkRegion ) ? ( psRefs ) : ( _poolLocalOf(psRefs)->psMarkRegion ) ;
+    for ( ; NULL != psRegion && NULL == pvResult; psRegion = psRegion->psInfo.psNext )
+    {
+        pvResult = _poolAllocRegion(psRegion, shiftDeg);
+    }
+
+    // ? every region is full, map one more if this pool can grow
+    if ( NULL == pvResult && NULL != ( psRegion = _poolGrow(psRefs, shiftDeg) ) )
+    {
+        pvResult = _poolAllocRegion(psRegion, shiftDeg);
+    }
+
+    if ( NULL == pvResult )
+    {
+        // ! error: memory not avalible
+        ++psRefs->psInfo.zFails;
+        return NULL;
+    }
+
+    ++psRefs->psInfo.zAllocs;
+    psRefs->psInfo.zLive += POOL_BLOCK(shiftDeg);
+    if ( psRefs->psInfo.zPeak < psRefs->psInfo.zLive )
+    {
+        psRefs->psInfo.zPeak = psRefs->psInfo.zLive;
+    }
+
+    return pvResult;
+}
+
+static
+pool_s *
+_poolEraseChain(
+    pool_s * const psRefs,
+    void * const pvTarget
+) {
+    pool_s * psRegion = NULL;
+    node_s * psNode = NULL;
+
+    psRegion = _poolRegionOf(psRefs, pvTarget);
+    psNode = _poolSearch(psRegion, pvTarget);
+    if ( NULL == psNode )
+    {
+        // ! error: not an allocated block of this pool
+        return NULL;
+    }
+
+    ++psRefs->psInfo.zErases;
+    psRefs->psInfo.zLive -= POOL_BLOCK(psNode->shiftDeg);
+
+    _poolEraseRegion(psRegion, psNode);
+
+    // ? hand the pages of an idle region back to the system, but keep it mapped for the next burst,
+    // ? the regions up to a checkpoint keep their floor until it is released
+    if ( psRegion != psRefs && POOL_BLOCK(psRegion->psHead.shiftDeg) == psRegion->psInfo.zUsage
+        && ( NULL == _poolLocalOf(psRefs)->psMarkRegion || NULL != _poolRegionOf(_poolLocalOf(psRefs)->psMarkRegion->psInfo.psNext, pvTarget) ) )
+    {
+        _poolIdle(psRegion);
+    }
+
+    return psRefs;
+}
+
+static
+void *
+_poolAllocShared(
+    pool_s * const psRefs,
+    const unsigned int shiftDeg
+) {
+    share_s * const psShare = _poolLocalOf(psRefs)->psShare;
+    cache_s * psCache = NULL;
+    void * pvResult = NULL;
+    unsigned int idx = shiftDeg - POOL_DEGREE_MIN;
+
+    psCache = ( shiftDeg <= POOL_CACHE_DEGREE_MAX ) ? _poolCacheOf(psRefs) : ( NULL ) ;
+    if ( NULL == psCache )
+    {
+        mtx_lock(&psShare->sLock);
+        pvResult = _poolAllocChain(psRefs, shiftDeg);
+        mtx_unlock(&psShare->sLock);
+        return pvResult;
+    }
+
+    if ( 0 == psCache->aCount[ idx ] )
+    {
+        // ? refill half of the magazine under one lock, the other half is room for the blocks coming back
+        mtx_lock(&psShare->sLock);
+        while ( psCache->aCount[ idx ] < POOL_CACHE_SIZE / 2 )
+        {
+            pvResult = _poolAllocChain(psRefs, shiftDeg);
+            if ( NULL == pvResult )
+            {
+                break;
+            }
+            psCache->aapBlock[ idx ][ psCache->aCount[ idx ]++ ] = pvResult;
+        }
+        mtx_unlock(&psShare->sLock);
+
+        if ( 0 == psCache->aCount[ idx ] )
+        {
+            // ! error: memory not avalible
+            return NULL;
+        }
+    }
+
+    pvResult = psCache->aapBlock[ idx ][ --psCache->aCount[ idx ] ];
+    ( (node_s *)pvResult - 1 )->nextDiff = 0;
+    return pvResult;
+}
+
+static
+pool_s *
+_poolEraseShared(
+    pool_s * const psRefs,
+    void * const pvTarget
+) {
+    share_s * const psShare = _poolLocalOf(psRefs)->psShare;
+    node_s * const psNode = (node_s *)pvTarget - 1;
+    cache_s * psCache = NULL;
+    pool_s * psResult = psRefs;
+    unsigned int idx = psNode->shiftDeg - POOL_DEGREE_MIN;
+
+    // ? the header of a small block is trusted here, it is checked when the block goes back to the pool, a shim is not cached
+    psCache = ( 0 != psNode->headDiff && POOL_DEGREE_MIN <= psNode->shiftDeg && psNode->shiftDeg <= POOL_CACHE_DEGREE_MAX ) ?
+        _poolCacheOf(psRefs) :
+        ( NULL ) ;
+    if ( NULL == psCache )
+    {
+        mtx_lock(&psShare->sLock);
+        psResult = _poolEraseChain(psRefs, pvTarget);
+        mtx_unlock(&psShare->sLock);
+        return psResult;
+    }
+
+    if ( POOL_PARKED == psNode->nextDiff )
+    {
+        // ! error: the block is parked already
+        return NULL;
+    }
+
+    if ( POOL_CACHE_SIZE == psCache->aCount[ idx ] )
+    {
+        mtx_lock(&psShare->sLock);
+        while ( psCache->aCount[ idx ] > POOL_CACHE_SIZE / 2 )
+        {
+            if ( NULL == _poolEraseChain(psRefs, psCache->aapBlock[ idx ][ --psCache->aCount[ idx ] ]) )
+            {
+                // ! error: a foreign pointer went through the cache
+                psResult = NULL;
+            }
+        }
+        mtx_unlock(&psShare->sLock);
+    }
+
+    psNode->nextDiff = POOL_PARKED;
+    psCache->aapBlock[ idx ][ psCache->aCount[ idx ]++ ] = pvTarget;
+    return psResult;
+}
+
+static
+cache_s *
+_poolCacheOf(
+    pool_s * const psRefs
+) {
+    share_s * const psShare = _poolLocalOf(psRefs)->psShare;
+    cache_s * psCache = (cache_s *)tss_get(psShare->sCache);
+    const unsigned int uEpoch = atomic_load(&psShare->uEpoch);
+    unsigned int idx = 0;
+
+    if ( NULL != psCache )
+    {
+        if ( uEpoch != psCache->uEpoch )
+        {
+            // ? the pool was reset, the parked blocks are gone already
+            for ( idx = 0; idx < POOL_CACHE_NUM; ++idx )
+            {
+                psCache->aCount[ idx ] = 0;
+            }
+            psCache->uEpoch = uEpoch;
+        }
+        return psCache;
+    }
+
+    psCache = (cache_s *)calloc(1, sizeof(cache_s));
+    if ( NULL == psCache )
+    {
+        return NULL; /* fall back to the locked path */
+    }
+
+    psCache->psPool = psRefs;
+    psCache->uEpoch = uEpoch;
+
+    mtx_lock(&psShare->sLock);
+    psCache->psNext = psShare->psCaches;
+    if ( NULL != psShare->psCaches )
+    {
+        psShare->psCaches->psPrev = psCache;
+    }
+    psShare->psCaches = psCache;
+    mtx_unlock(&psShare->sLock);
+
+    if ( thrd_success != tss_set(psShare->sCache, psCache) )
+    {
+        _poolCacheDrop(psCache);
+        return NULL;
+    }
+
+    return psCache;
+}
+
+static
+void
+_poolCacheFlush(
+    pool_s * const psRefs
+) {
+    cache_s * psCache = NULL;
+    const unsigned int uEpoch = atomic_load(&_poolLocalOf(psRefs)->psShare->uEpoch);
+    unsigned int idx = 0;
+
+    // ? called under the lock, a cache left behind by a reset holds nothing of the pool anymore
+    for ( psCache = _poolLocalOf(psRefs)->psShare->psCaches; NULL != psCache; psCache = psCache->psNext )
+    {
+        for ( idx = 0; idx < POOL_CACHE_NUM; ++idx )
+        {
+            while ( 0 != psCache->aCount[ idx ] )
+            {
+                --psCache->aCount[ idx ];
+                if ( uEpoch == psCache->uEpoch )
+                {
+                    _poolEraseChain(psRefs, psCache->aapBlock[ idx ][ psCache->aCount[ idx ] ]);
+                }
+            }
+        }
+    }
+}
+
+static
+void
+_poolCacheDrop(
+    void * pvCache
+) {
+    cache_s * const psCache = (cache_s *)( pvCache );
+    pool_s * const psRefs = psCache->psPool;
+    share_s * const psShare = _poolLocalOf(psRefs)->psShare;
+    unsigned int idx = 0;
+
+    mtx_lock(&psShare->sLock);
+
+    // ? the thread is gone, its parked blocks go back to the pool unless the pool dropped them already
+    if ( atomic_load(&psShare->uEpoch) == psCache->uEpoch )
+    {
+        for ( idx = 0; idx < POOL_CACHE_NUM; ++idx )
+        {
+            while ( 0 != psCache->aCount[ idx ] )
+            {
+                _poolEraseChain(psRefs, psCache->aapBlock[ idx ][ --psCache->aCount[ idx ] ]);
+            }
+        }
+    }
+
+    if ( NULL == psCache->psPrev )
+    {
+        psShare->psCaches = psCache->psNext;
+    }
+    else
+    {
+        psCache->psPrev->psNext = psCache->psNext;
+    }
+
+    if ( NULL != psCache->psNext )
+    {
+        psCache->psNext->psPrev = psCache->psPrev;
+    }
+
+    mtx_unlock(&psShare->sLock);
+    free(psCache);
+}
+
+static
+void
+_poolLock(
+    pool_s const * const psRefs
+) {
+    if ( NULL != psRefs && NULL != _poolLocalOf(psRefs)->psShare )
+    {
+        mtx_lock(&_poolLocalOf(psRefs)->psShare->sLock);
+    }
+}
+
+static
+void
+_poolUnlock(
+    pool_s const * const psRefs
+) {
+    if ( NULL != psRefs && NULL != _poolLocalOf(psRefs)->psShare )
+    {
+        mtx_unlock(&_poolLocalOf(psRefs)->psShare->sLock);
+    }
+}
+
+static
+bool
+_poolDropped(
+    pool_mark_s const * const psMark,
+    void const * const pvTarget
+) {
+    pool_s const * psRegion = psMark->psRegion;
+
+    if ( (void const *)psRegion < pvTarget && pvTarget < (void const *)psRegion->psInfo.psBoundary )
+    {
+        return _poolOffsetOf(psRegion, (node_s const *)pvTarget) >= psMark->zFrontier;
+    }
+
+    // ? the regions after the checkpoint are dropped as a whole, the ones in front of it are kept
+    return NULL != _poolRegionOf(psRegion->psInfo.psNext, pvTarget);
+}
+
+static
+void
+_poolReleaseSlabs(
+    pool_s * const psRefs,
+    pool_mark_s const * const psMark
+) {
+    slab_mark_s * const psSlabMark = (slab_mark_s *)psMark->pvSlabs;
+    slab_s ** ppsLink = &psRefs->psInfo.psSlabs;
+    slab_s * psSlab = NULL;
+    void ** ppvLink = NULL;
+    size_t zKeep = 0;
+    size_t idx = 0;
+
+    while ( NULL != ( psSlab = *ppsLink ) )
+    {
+        if ( _poolDropped(psMark, psSlab) )
+        {
+            *ppsLink = psSlab->psNext; /* made after the checkpoint */
+            continue;
+        }
+
+        // ? a slab made before the checkpoint loses the pages and the objects taken after it
+        if ( NULL != psSlab->pvPages && _poolDropped(psMark, psSlab->pvPages) )
+        {
+            psSlab->pCarve = psSlab->pCarveEnd = NULL;
+        }
+
+        for ( ppvLink = &psSlab->pvPages; NULL != *ppvLink; )
+        {
+            if ( _poolDropped(psMark, *ppvLink) )
+            {
+                *ppvLink = *(void **)*ppvLink;
+            }
+            else
+            {
+                ppvLink = (void **)*ppvLink;
+            }
+        }
+
+        // ? an index made after the checkpoint is gone, an older one keeps the pages that are left, in order
+        if ( NULL != psSlab->apIndex && _poolDropped(psMark, psSlab->apIndex) )
+        {
+            psSlab->apIndex = NULL;
+        }
+
+        for ( idx = 0, zKeep = 0; NULL != psSlab->apIndex && idx < psSlab->zIndex; ++idx )
+        {
+            if ( false == _poolDropped(psMark, psSlab->apIndex[ idx ]) )
+            {
+                psSlab->apIndex[ zKeep++ ] = psSlab->apIndex[ idx ];
+            }
+        }
+        psSlab->zIndex = ( NULL == psSlab->apIndex ) ? ( 0 ) : ( zKeep ) ;
+        psSlab->pLastPage = NULL;
+
+        for ( ppvLink = &psSlab->pvFree; NULL != *ppvLink; )
+        {
+            if ( _poolDropped(psMark, *ppvLink) )
+            {
+                *ppvLink = *(void **)*ppvLink;
+            }
+            else
+            {
+                ppvLink = (void **)*ppvLink;
+            }
+        }
+
+        // ? the objects that were free and the page part that was untouched at the checkpoint come back
+        for ( idx = 0; NULL != psSlabMark && idx < psSlabMark->zCount; ++idx )
+        {
+            if ( psSlab == psSlabMark->asSlab[ idx ].psSlab )
+            {
+                *ppvLink = psSlabMark->asSlab[ idx ].pvFree;
+                psSlab->pCarve = psSlabMark->asSlab[ idx ].pCarve;
+                psSlab->pCarveEnd = psSlabMark->asSlab[ idx ].pCarveEnd;
+            }
+        }
+
+        ppsLink = &psSlab->psNext;
+    }
+}
+
+static
+slab_mark_s *
+_poolMarkSlabs(
+    pool_s * const psRefs
+) {
+    slab_mark_s * psMark = NULL;
+    slab_s * psSlab = NULL;
+    size_t zCount = 0;
+    unsigned int shiftDeg = 0;
+
+    for ( psSlab = psRefs->psInfo.psSlabs; NULL != psSlab; psSlab = psSlab->psNext )
+    {
+        ++zCount;
+    }
+
+    shiftDeg = _poolComputeShiftDegree( sizeof(node_s) + sizeof(slab_mark_s) + zCount * sizeof(psMark->asSlab[ 0 ]) );
+    psMark = ( 0 == shiftDeg ) ? ( NULL ) : (slab_mark_s *)_poolAllocChain(psRefs, shiftDeg) ;
+    if ( NULL == psMark )
+    {
+        return NULL;
+    }
+
+    psMark->psOuter = _poolLocalOf(psRefs)->psSlabMark;
+    psMark->zCount = zCount;
+
+    // ? a sealed slab takes nothing from before the checkpoint, whatever it hands out later lies beyond it
+    for ( psSlab = psRefs->psInfo.psSlabs, zCount = 0; NULL != psSlab; psSlab = psSlab->psNext, ++zCount )
+    {
+        psMark->asSlab[ zCount ].psSlab = psSlab;
+        psMark->asSlab[ zCount ].pvFree = psSlab->pvFree;
+        psMark->asSlab[ zCount ].pCarve = psSlab->pCarve;
+        psMark->asSlab[ zCount ].pCarveEnd = psSlab->pCarveEnd;
+
+        psSlab->pvFree = NULL;
+        psSlab->pCarve = psSlab->pCarveEnd = NULL;
+    }
+
+    _poolLocalOf(psRefs)->psSlabMark = psMark;
+    return psMark;
+}
+
+static
+bool
+_poolExtend(
+    pool_s * const psRefs,
+    node_s * const psNode,
+    const unsigned int shiftDeg
+) {
+    const size_t zTail = (char *)psRefs->psInfo.psBoundary - (char *)&psRefs->psHead;
+    const size_t zOffset = _poolOffsetOf(psRefs, psNode);
+    const size_t zEnd = zOffset + POOL_BLOCK(shiftDeg);
+    node_s * psNext = NULL;
+    size_t zPos = 0;
+    unsigned int deg = 0;
+
+    if ( zOffset < psRefs->psInfo.zFloor )
+    {
+        return false; /* frozen by a checkpoint, growing it would cross the floor */
+    }
+
+    if ( PMBuddy == psRefs->psInfo.eMode && 0 != ( ( zOffset - POOL_BLOCK(psRefs->psHead.shiftDeg) ) & ( POOL_BLOCK(shiftDeg) - 1 ) ) )
+    {
+        return false; /* the grown block would not be aligned to its size */
+    }
+
+    // ? every block up to the new end must be free, or not handed out yet
+    for ( zPos = zOffset + POOL_BLOCK(psNode->shiftDeg); zPos < zEnd && zPos < psRefs->psInfo.zFrontier; zPos += POOL_BLOCK(psNext->shiftDeg) )
+    {
+        psNext = _poolNodeAt(psRefs, zPos);
+        if ( 0 != psNext->headDiff )
+        {
+            return false;
+        }
+    }
+
+    if ( zPos < zEnd && zEnd > zTail )
+    {
+        return false;
+    }
+
+    for ( zPos = zOffset + POOL_BLOCK(psNode->shiftDeg); zPos < zEnd && zPos < psRefs->psInfo.zFrontier; zPos += POOL_BLOCK(psNext->shiftDeg) )
+    {
+        psNext = _poolNodeAt(psRefs, zPos);
+        _poolDropFree(psRefs, psNext);
+    }
+
+    // ? only in segregated mode the last free block can reach past the new end, the rest is released again
+    while ( zEnd < zPos )
+    {
+        for ( deg = POOL_DEGREE_MAX; POOL_BLOCK(deg) > zPos - zEnd; --deg ) { }
+        zPos -= POOL_BLOCK(deg);
+        _poolPushFree(psRefs, _poolNodeAt(psRefs, zPos), deg);
+    }
+
+    if ( psRefs->psInfo.zFrontier < zEnd )
+    {
+        psRefs->psInfo.zFrontier = zEnd;
+    }
+
+    psRefs->psInfo.zUsage += POOL_BLOCK(shiftDeg) - POOL_BLOCK(psNode->shiftDeg);
+    psNode->shiftDeg = shiftDeg;
+    return true;
+}
+
+static
+void
+_poolShrink(
+    pool_s * const psRefs,
+    node_s * const psNode,
+    const unsigned int shiftDeg
+) {
+    const unsigned int uOldDeg = psNode->shiftDeg;
+    node_s * psTail = NULL;
+    unsigned int deg = uOldDeg;
+
+    // ? cut the upper halves into blocks first, so the frontier can only retreat over whole blocks
+    for ( psNode->shiftDeg = shiftDeg; deg > shiftDeg; --deg )
+    {
+        psTail = (node_s *)( (char *)psNode + POOL_BLOCK(deg - 1) );
+        psTail->headDiff = POOL_GRAIN( _poolOffsetOf(psRefs, psTail) );
+        psTail->nextDiff = 0;
+        psTail->shiftDeg = deg - 1;
+    }
+
+    // ? then hand them back, the farthest first so that a block at the frontier lets it retreat
+    for ( deg = uOldDeg; deg > shiftDeg; --deg )
+    {
+        _poolEraseRegion(psRefs, (node_s *)( (char *)psNode + POOL_BLOCK(deg - 1) ));
+    }
+}
+
+static
+void *
+_poolAllocAligned(
+    pool_s * const psRefs,
+    const size_t zAllocSize,
+    const size_t zAlign
+) {
+    node_s * psShim = NULL;
+    char * pBlock = NULL;
+    size_t zShift = 0;
+    unsigned int shiftDeg = 0;
+
+    // ? payloads sit 8 bytes past a 16 bytes grain, so the shift is at most ( zAlign - 8 ) from a 16 bytes aligned buffer
+    shiftDeg = ( zAllocSize > POOL_BLOCK(POOL_DEGREE_MAX) - zAlign ) ?
+        ( 0 ) :
+        _poolComputeShiftDegree( zAlign + zAllocSize ) ;
+    if ( 0 == shiftDeg )
+    {
+        // ! error: out of range, larger than the biggest block
+        ++psRefs->psInfo.zFails;
+        return NULL;
+    }
+
+    pBlock = (char *)_poolAllocChain(psRefs, shiftDeg);
+    if ( NULL == pBlock )
+    {
+        return NULL;
+    }
+
+    zShift = ( zAlign - ( (uintptr_t)pBlock & ( zAlign - 1 ) ) ) & ( zAlign - 1 );
+    if ( 0 == zShift )
+    {
+        return pBlock;
+    }
+
+    if ( zShift < sizeof(node_s) || sizeof(node_s) + zShift + zAllocSize > POOL_BLOCK(shiftDeg) )
+    {
+        // ! error: the pool buffer is not 16 bytes aligned, there is no room for the shim
+        _poolEraseChain(psRefs, pBlock);
+        ++psRefs->psInfo.zFails;
+        return NULL;
+    }
+
+    psShim = (node_s *)( pBlock + zShift ) - 1;
+    psShim->headDiff = ( (node_s *)pBlock - 1 )->headDiff;
+    psShim->nextDiff = zShift;
+    psShim->shiftDeg = 0;
+
+    return pBlock + zShift;
+}
+
+static
+void *
+_poolHandleOf(
+    pool_s const * const psRefs,
+    const pool_handle_t uHandle
+) {
+    handle_s const * psHandles = NULL;
+
+    if ( NULL == psRefs || NULL == ( psHandles = _poolLocalOf(psRefs)->psHandles ) || 0 == uHandle || psHandles->uSize < uHandle )
+    {
+        return NULL;
+    }
+
+    return ( 0 != ( 1 & psHandles->aEntry[ uHandle - 1 ] ) ) ? ( NULL ) : (void *)psHandles->aEntry[ uHandle - 1 ] ;
+}
+
+static
+pool_handle_t
+_poolHandleTake(
+    pool_s * const psRefs
+) {
+    handle_s * psHandles = _poolLocalOf(psRefs)->psHandles;
+    pool_handle_t uHandle = 0;
+    uint32_t uSize = 0;
+
+    if ( NULL == psHandles || 0 == psHandles->uFree )
+    {
+        // ? double the table, the handles keep their index
+        uSize = ( NULL == psHandles ) ? ( 64 ) : ( 2 * psHandles->uSize ) ;
+        if ( POOL_HANDLE_MAX < uSize )
+        {
+            return 0;
+        }
+
+        psHandles = (handle_s *)realloc(psHandles, sizeof(handle_s) + uSize * sizeof(uintptr_t));
+        if ( NULL == psHandles )
+        {
+            return 0;
+        }
+
+        if ( NULL == _poolLocalOf(psRefs)->psHandles )
+        {
+            psHandles->uSize = 0;
+            psHandles->uFree = 0;
+        }
+
+        while ( psHandles->uSize < uSize )
+        {
+            psHandles->aEntry[ psHandles->uSize ] = ( (uintptr_t)psHandles->uFree << 1 ) | 1;
+            psHandles->uFree = ++psHandles->uSize;
+        }
+
+        _poolLocalOf(psRefs)->psHandles = psHandles;
+    }
+
+    uHandle = psHandles->uFree;
+    psHandles->uFree = (uint32_t)( psHandles->aEntry[ uHandle - 1 ] >> 1 );
+    return uHandle;
+}
+
+static
+void
+_poolHandleDrop(
+    pool_s * const psRefs,
+    const pool_handle_t uHandle
+) {
+    handle_s * const psHandles = _poolLocalOf(psRefs)->psHandles;
+
+    psHandles->aEntry[ uHandle - 1 ] = ( (uintptr_t)psHandles->uFree << 1 ) | 1;
+    psHandles->uFree = uHandle;
+}
+
+static
+void
+_poolReleaseHandles(
+    pool_s * const psRefs,
+    pool_mark_s const * const psMark
+) {
+    handle_s const * const psHandles = _poolLocalOf(psRefs)->psHandles;
+    pool_handle_t uHandle = 0;
+
+    if ( NULL == psHandles )
+    {
+        return;
+    }
+
+    // ? the handles of released blocks are unused again
+    for ( uHandle = 1; uHandle <= psHandles->uSize; ++uHandle )
+    {
+        if ( NULL != _poolHandleOf(psRefs, uHandle) && _poolDropped(psMark, _poolHandleOf(psRefs, uHandle)) )
+        {
+            _poolHandleDrop(psRefs, uHandle);
+        }
+    }
+}
+
+static
+void
+_poolCompactRegion(
+    pool_s * const psRefs,
+    pool_s * const psRegion
+) {
+    handle_s * const psHandles = _poolLocalOf(psRefs)->psHandles;
+    node_s * psNode = NULL;
+    size_t zOffset = 0;
+    size_t zSize = 0;
+    size_t zDest = POOL_BLOCK(psRegion->psHead.shiftDeg);
+    unsigned int idx = 0;
+
+    // ? the free lists are rebuilt from the gaps left in front of the pinned blocks
+    for ( idx = 0; idx < POOL_DEGREE_NUM; ++idx )
+    {
+        psRegion->psInfo.aFreeList[ idx ] = 0;
+    }
+    psRegion->psInfo.uFreeMap = 0;
+    psRegion->psInfo.uFlags &= ~( POOL_FLAG_LOOSE | POOL_FLAG_SHELF );
+
+    for ( zOffset = zDest; zOffset < psRegion->psInfo.zFrontier; zOffset += zSize )
+    {
+        psNode = _poolNodeAt(psRegion, zOffset);
+        zSize = POOL_BLOCK(psNode->shiftDeg);
+
+        if ( 0 == psNode->headDiff )
+        {
+            continue; /* free, its bytes join the gap */
+        }
+
+        // ? only a block whose handle still points at it may move, any other block is pinned by raw pointers
+        if ( NULL == psHandles || 0 == psNode->nextDiff || psHandles->uSize < psNode->nextDiff || (uintptr_t)( psNode + 1 ) != psHandles->aEntry[ psNode->nextDiff - 1 ] )
+        {
+            zDest = _poolPushGap(psRegion, zDest, zOffset) + zSize;
+            continue;
+        }
+
+        if ( zDest < zOffset )
+        {
+            memmove(_poolNodeAt(psRegion, zDest), psNode, zSize);
+            psNode = _poolNodeAt(psRegion, zDest);
+            psNode->headDiff = POOL_GRAIN(zDest);
+            psHandles->aEntry[ psNode->nextDiff - 1 ] = (uintptr_t)( psNode + 1 );
+        }
+
+        zDest += zSize;
+    }
+
+    psRegion->psInfo.zFrontier = zDest;
+}
+
+static
+size_t
+_poolPushGap(
+    pool_s * const psRefs,
+    size_t zBegin,
+    const size_t zEnd
+) {
+    unsigned int deg = 0;
+
+    // ? segregated blocks need no alignment, so the largest power of two goes first
+    while ( zBegin < zEnd )
+    {
+        for ( deg = POOL_DEGREE_MAX; POOL_BLOCK(deg) > zEnd - zBegin; --deg ) { }
+        _poolPushFree(psRefs, _poolNodeAt(psRefs, zBegin), deg);
+        zBegin += POOL_BLOCK(deg);
+    }
+
+    return zEnd;
+}
+
+static
+int
+_poolOpenFile(
+    char const * const pPath,
+    const size_t zFileSize,
+    const unsigned int uFlags,
+    size_t * const pzSize,
+    bool * const pbMade
+) {
+    struct stat sStat;
+    int fd = -1;
+
+    // ? a private pool never writes back, so it only needs to read an existing file
+    // ? a file made here is told apart from an empty one which was there, only the first is removed on a failure
+    *pbMade = false;
+    if ( 0 != ( PFPrivate & uFlags ) )
+    {
+        fd = open(pPath, O_RDONLY | O_CLOEXEC);
+    }
+    else
+    {
+        fd = open(pPath, O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+        *pbMade = ( 0 <= fd );
+        fd = ( 0 > fd && EEXIST == errno ) ? ( open(pPath, O_RDWR | O_CLOEXEC) ) : ( fd ) ;
+    }
+
+    if ( 0 > fd )
+    {
+        return -1;
+    }
+
+    if ( 0 != fstat(fd, &sStat) )
+    {
+        close(fd);
+        return -1;
+    }
+
+    *pzSize = (size_t)sStat.st_size;
+    if ( 0 == *pzSize && ( 0 != ( PFPrivate & uFlags ) || 0 == zFileSize || 0 != ftruncate(fd, (off_t)zFileSize) ) )
+    {
+        // ! error: a private pool cannot format a new file, and an empty one needs a size
+        close(fd);
+        return -1;
+    }
+
+    return fd;
+}
+
+static
+pool_s *
+_poolMapFile(
+    const int fd,
+    const size_t zSize,
+    const pool_mode_e eMode,
+    const unsigned int uFlags,
+    const bool bCreate
+) {
+    const int prot = PROT_READ | PROT_WRITE;
+    const int share = ( 0 != ( PFPrivate & uFlags ) ) ? ( MAP_PRIVATE ) : ( MAP_SHARED ) ;
+    const size_t zPage = (size_t)sysconf(_SC_PAGESIZE);
+    file_s sHeader;
+    file_s * psFile = NULL;
+    pool_s * psRefs = NULL;
+    void * pvBuffer = MAP_FAILED;
+    char * pLocal = MAP_FAILED;
+
+    if ( sizeof(file_s) >= zSize || POOL_SPAN_MAX < zSize - sizeof(file_s) )
+    {
+        // ! error: the size is out of range
+        return NULL;
+    }
+
+    // ? a private page goes in front of the file, it keeps the state of this process out of the file
+    if ( bCreate )
+    {
+        pLocal = (char *)mmap(NULL, zPage + zSize, prot, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    }
+    else
+    {
+        // ? read the header first, the mapping has to land where the pool was made
+        if ( (ssize_t)sizeof(file_s) != pread(fd, &sHeader, sizeof(file_s), 0) )
+        {
+            return NULL;
+        }
+
+        if ( POOL_FILE_MAGIC != sHeader.uMagic || POOL_FILE_VERSION != sHeader.uVersion || sizeof(file_s) != sHeader.uHeader || zSize != sHeader.uSize )
+        {
+            // ! error: not a pool file, or made by another version
+            return NULL;
+        }
+
+#ifdef MAP_FIXED_NOREPLACE
+        pLocal = (char *)mmap((void *)(uintptr_t)( sHeader.uBase - zPage ), zPage + zSize, prot, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+#else
+        pLocal = (char *)mmap((void *)(uintptr_t)( sHeader.uBase - zPage ), zPage + zSize, prot, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+#endif /* MAP_FIXED_NOREPLACE */
+        if ( MAP_FAILED != (void *)pLocal && (uintptr_t)( pLocal + zPage ) != sHeader.uBase )
+        {
+            // ! error: the address is taken, the pointers in the payload would be wrong
+            munmap(pLocal, zPage + zSize);
+            return NULL;
+        }
+    }
+
+    if ( MAP_FAILED == (void *)pLocal )
+    {
+        return NULL;
+    }
+
+    // ? the file replaces the reserved range behind the private page
+    pvBuffer = mmap(pLocal + zPage, zSize, prot, share | MAP_FIXED, fd, 0);
+    if ( MAP_FAILED == pvBuffer )
+    {
+        munmap(pLocal, zPage + zSize);
+        return NULL;
+    }
+
+#ifdef MADV_HUGEPAGE
+    if ( 0 != ( PFHugePage & uFlags ) )
+    {
+        madvise(pvBuffer, zSize, MADV_HUGEPAGE); /* only a hint, a failure is harmless */
+    }
+#endif /* MADV_HUGEPAGE */
+
+    psFile = (file_s *)pvBuffer;
+    psRefs = (pool_s *)( psFile + 1 );
+
+    if ( bCreate )
+    {
+        if ( NULL == poolFormatMode(psRefs, zSize - sizeof(file_s), eMode) )
+        {
+            munmap(pLocal, zPage + zSize);
+            return NULL;
+        }
+
+        psFile->uMagic = POOL_FILE_MAGIC;
+        psFile->uVersion = POOL_FILE_VERSION;
+        psFile->uHeader = sizeof(file_s);
+        psFile->uSize = zSize;
+        psFile->uBase = (uint64_t)(uintptr_t)pvBuffer;
+        psFile->uRoot = 0;
+    }
+    else if ( false == _poolCheck(psRefs, zSize - sizeof(file_s)) )
+    {
+        // ! error: the pool in the file is damaged
+        munmap(pLocal, zPage + zSize);
+        return NULL;
+    }
+
+    // ? the private page starts empty, the checkpoints of the process which wrote the file are gone
+    psRefs->psInfo.uFlags = ( uFlags & ( PFHugePage | PFPrivate ) ) | ( psRefs->psInfo.uFlags & ( POOL_FLAG_LOOSE | POOL_FLAG_SHELF ) ) | POOL_FLAG_FILE;
+    psRefs->psInfo.zFloor = 0;
+
+    // ? the blocks its checkpoints left off the lists are listed again
+    if ( 0 != ( POOL_FLAG_SHELF & psRefs->psInfo.uFlags ) )
+    {
+        _poolMergeRegion(psRefs);
+    }
+
+    return psRefs;
+}
+
+static
+bool
+_poolCheck(
+    pool_s const * const psRefs,
+    const size_t zSize
+) {
+    const size_t zBase = POOL_BLOCK(psRefs->psHead.shiftDeg);
+    const size_t zTail = (char *)psRefs->psInfo.psBoundary - (char *)&psRefs->psHead;
+    node_s * psNode = NULL;
+    size_t zOffset = 0;
+    size_t zUsage = zBase;
+    size_t zFreeNum = 0;
+    size_t zTiled = 0;
+    uint32_t uNext = 0;
+    uint32_t uPrev = 0;
+    unsigned int idx = 0;
+
+    // ? the header of the pool
+    if ( ( PMSegregate != psRefs->psInfo.eMode && PMBuddy != psRefs->psInfo.eMode ) || _poolComputeShiftDegree( sizeof(pool_s) ) != psRefs->psHead.shiftDeg )
+    {
+        return false;
+    }
+
+    if ( (char *)psRefs + zSize != (char *)psRefs->psInfo.psBoundary || 0 != psRefs->psInfo.zRegion || NULL != psRefs->psInfo.psNext )
+    {
+        return false;
+    }
+
+    if ( zBase > psRefs->psInfo.zFrontier || zTail < psRefs->psInfo.zFrontier || 0 != ( psRefs->psInfo.zFrontier & ( POOL_BLOCK(POOL_DEGREE_MIN) - 1 ) ) )
+    {
+        return false;
+    }
+
+    // ? every free list is linked both ways, and holds blocks of its own degree
+    for ( idx = 0; idx < POOL_DEGREE_NUM; ++idx )
+    {
+        if ( ( 0 != psRefs->psInfo.aFreeList[ idx ] ) != ( 0 != ( psRefs->psInfo.uFreeMap & ( (uint32_t)1 << idx ) ) ) )
+        {
+            return false;
+        }
+
+        for ( uPrev = 0, uNext = psRefs->psInfo.aFreeList[ idx ]; 0 != uNext; uPrev = uNext, uNext = psNode->nextDiff )
+        {
+            if ( POOL_BYTES(uNext) < zBase || POOL_BYTES(uNext) >= psRefs->psInfo.zFrontier || ++zFreeNum > POOL_GRAIN(zTail) )
+            {
+                return false;
+            }
+
+            psNode = _poolNodeAt(psRefs, POOL_BYTES(uNext));
+            if ( 0 != psNode->headDiff || idx + POOL_DEGREE_MIN != psNode->shiftDeg || uPrev != *_poolPrevFree(psNode) )
+            {
+                return false;
+            }
+        }
+    }
+
+    // ? the blocks tile the pool up to the frontier, and the usage adds up
+    for ( zOffset = zBase; zOffset < psRefs->psInfo.zFrontier; zOffset += POOL_BLOCK(psNode->shiftDeg) )
+    {
+        psNode = _poolNodeAt(psRefs, zOffset);
+        if ( POOL_DEGREE_MIN > psNode->shiftDeg || POOL_DEGREE_MAX < psNode->shiftDeg || zOffset + POOL_BLOCK(psNode->shiftDeg) > psRefs->psInfo.zFrontier )
+        {
+            return false;
+        }
+
+        if ( PMBuddy == psRefs->psInfo.eMode && 0 != ( ( zOffset - zBase ) & ( POOL_BLOCK(psNode->shiftDeg) - 1 ) ) )
+        {
+            return false; /* a buddy block starts at a multiple of its size */
+        }
+
+        if ( 0 == psNode->headDiff )
+        {
+            ++zTiled;
+        }
+        else if ( POOL_GRAIN(zOffset) == psNode->headDiff )
+        {
+            zUsage += POOL_BLOCK(psNode->shiftDeg);
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    // ? a checkpoint may have left free blocks off the lists until its release
+    if ( ( zFreeNum != zTiled && ( 0 == ( POOL_FLAG_SHELF & psRefs->psInfo.uFlags ) || zFreeNum > zTiled ) ) || zUsage != psRefs->psInfo.zUsage )
+    {
+        return false;
+    }
+
+    if ( false == _poolCheckSlabs(psRefs) )
+    {
+        return false;
+    }
+
+    // ? the root has to be an allocated block
+    return 0 == _poolFileOf(psRefs)->uRoot || NULL != _poolSearch(psRefs, (char const *)psRefs + _poolFileOf(psRefs)->uRoot);
+}
+
+static
+bool
+_poolCheckSlabs(
+    pool_s const * const psRefs
+) {
+    const size_t zTail = (char *)psRefs->psInfo.psBoundary - (char *)&psRefs->psHead;
+    slab_s const * psSlab = NULL;
+    node_s const * psNode = NULL;
+    char ** apPage = NULL;
+    char * pPage = NULL;
+    void * pvLink = NULL;
+    size_t zSlabNum = 0;
+    size_t zPageNum = 0;
+    size_t zFreeNum = 0;
+    size_t zLow = 0;
+    size_t idx = 0;
+    bool bLast = false;
+    bool bResult = true;
+
+    // ? a slab lives in an allocated block of this pool, and owns what it points at
+    for ( psSlab = psRefs->psInfo.psSlabs; bResult && NULL != psSlab; psSlab = psSlab->psNext )
+    {
+        psNode = _poolCheckBlock(psRefs, psSlab);
+        if ( ++zSlabNum > POOL_GRAIN(zTail) || NULL == psNode || psNode->shiftDeg < _poolComputeShiftDegree( sizeof(node_s) + sizeof(slab_s) ) )
+        {
+            return false;
+        }
+
+        if ( psRefs != psSlab->psPool || 0 == psSlab->zRefs || 0 == psSlab->zSize || SLAB_OBJECT_MAX < psSlab->zSize || SLAB_ALIGN(psSlab->zSize) != psSlab->zSize )
+        {
+            return false;
+        }
+
+        // ? every page is an allocated block of the page size, and the page of the last erase is one of them
+        zPageNum = 0;
+        bLast = ( NULL == psSlab->pLastPage );
+        for ( pvLink = psSlab->pvPages; NULL != pvLink; pvLink = *(void **)pvLink )
+        {
+            psNode = _poolCheckBlock(psRefs, pvLink);
+            if ( ++zPageNum > ( zTail >> SLAB_PAGE_DEGREE ) || NULL == psNode || SLAB_PAGE_DEGREE != psNode->shiftDeg )
+            {
+                return false;
+            }
+            bLast = bLast || pvLink == psSlab->pLastPage;
+        }
+
+        if ( false == bLast )
+        {
+            return false;
+        }
+
+        // ? the untouched part belongs to the newest page
+        pPage = (char *)psSlab->pvPages;
+        if ( ( NULL == psSlab->pCarve ) != ( NULL == psSlab->pCarveEnd ) )
+        {
+            return false;
+        }
+
+        if ( NULL != psSlab->pCarve &&
+            ( NULL == pPage || psSlab->pCarveEnd != pPage + POOL_BLOCK(SLAB_PAGE_DEGREE) - sizeof(node_s) ||
+              psSlab->pCarve < pPage + sizeof(void *) || psSlab->pCarve > psSlab->pCarveEnd ||
+              0 != (size_t)( psSlab->pCarve - pPage - sizeof(void *) ) % psSlab->zSize ) )
+        {
+            return false;
+        }
+
+        // ? the index holds every page once and in order, in a block of its own
+        if ( NULL != psSlab->apIndex )
+        {
+            psNode = _poolCheckBlock(psRefs, psSlab->apIndex);
+            if ( NULL == psNode || zPageNum != psSlab->zIndex || psSlab->zIndex * sizeof(char *) > POOL_BLOCK(psNode->shiftDeg) - sizeof(node_s) )
+            {
+                return false;
+            }
+
+            for ( idx = 1; idx < psSlab->zIndex; ++idx )
+            {
+                if ( psSlab->apIndex[ idx - 1 ] >= psSlab->apIndex[ idx ] )
+                {
+                    return false;
+                }
+            }
+
+            for ( pvLink = psSlab->pvPages; NULL != pvLink; pvLink = *(void **)pvLink )
+            {
+                zLow = _poolSlabFind(psSlab->apIndex, psSlab->zIndex, (char *)pvLink);
+                if ( zLow == psSlab->zIndex || pvLink != psSlab->apIndex[ zLow ] )
+                {
+                    return false;
+                }
+            }
+        }
+
+        if ( NULL == psSlab->pvFree )
+        {
+            continue;
+        }
+
+        // ? a free object sits on an object boundary of one of the pages, in front of the untouched part
+        apPage = (char **)malloc(zPageNum * sizeof(char *));
+        if ( NULL == apPage )
+        {
+            return false;
+        }
+
+        for ( zPageNum = 0, pvLink = psSlab->pvPages; NULL != pvLink; pvLink = *(void **)pvLink )
+        {
+            apPage[ zPageNum++ ] = (char *)pvLink;
+        }
+        qsort(apPage, zPageNum, sizeof(char *), _poolComparePage);
+
+        zFreeNum = 0;
+        for ( pvLink = psSlab->pvFree; NULL != pvLink; pvLink = *(void **)pvLink )
+        {
+            // ? the last page which starts in front of the object
+            zLow = _poolSlabFind(apPage, zPageNum, (char *)pvLink);
+            pPage = ( 0 == zLow ) ? ( NULL ) : ( apPage[ zLow - 1 ] ) ;
+            bResult = ++zFreeNum <= ( zPageNum << SLAB_PAGE_DEGREE ) / psSlab->zSize && NULL != pPage &&
+                (char *)pvLink >= pPage + sizeof(void *) &&
+                (char *)pvLink + psSlab->zSize <= pPage + POOL_BLOCK(SLAB_PAGE_DEGREE) - sizeof(node_s) &&
+                0 == (size_t)( (char *)pvLink - pPage - sizeof(void *) ) % psSlab->zSize &&
+                ( pPage != psSlab->pvPages || NULL == psSlab->pCarve || (char *)pvLink < psSlab->pCarve );
+            if ( false == bResult )
+            {
+                break; /* the link of a stray object is not read */
+            }
+        }
+
+        free(apPage);
+    }
+
+    return bResult;
+}
+
+static
+bool
+_poolSlabOwns(
+    slab_s * const psSlab,
+    void const * const pvTarget
+) {
+    char const * const pTarget = (char const *)pvTarget;
+    char const * pPage = NULL;
+    size_t zPos = 0;
+
+    if ( NULL == psSlab->apIndex )
+    {
+        _poolSlabIndex(psSlab);
+    }
+
+    // ? the page is looked up in the index, or searched along the chain if there was no room for one
+    if ( NULL != psSlab->pLastPage && pTarget >= psSlab->pLastPage && pTarget < psSlab->pLastPage + POOL_BLOCK(SLAB_PAGE_DEGREE) )
+    {
+        pPage = psSlab->pLastPage;
+    }
+    else if ( NULL != psSlab->apIndex )
+    {
+        zPos = _poolSlabFind(psSlab->apIndex, psSlab->zIndex, pTarget);
+        pPage = ( 0 == zPos ) ? ( NULL ) : ( psSlab->apIndex[ zPos - 1 ] ) ;
+    }
+    else
+    {
+        for ( pPage = (char const *)psSlab->pvPages; NULL != pPage; pPage = *(char const * const *)pPage )
+        {
+            if ( pTarget >= pPage && pTarget < pPage + POOL_BLOCK(SLAB_PAGE_DEGREE) )
+            {
+                break;
+            }
+        }
+    }
+
+    psSlab->pLastPage = (char *)pPage;
+
+    // ? an object sits on an object boundary of its page, in front of the untouched part of the newest one
+    return NULL != pPage &&
+        pTarget >= pPage + sizeof(void *) &&
+        pTarget + psSlab->zSize <= pPage + POOL_BLOCK(SLAB_PAGE_DEGREE) - sizeof(node_s) &&
+        0 == (size_t)( pTarget - pPage - sizeof(void *) ) % psSlab->zSize &&
+        ( pPage != psSlab->pvPages || NULL == psSlab->pCarve || pTarget < psSlab->pCarve );
+}
+
+static
+void
+_poolSlabIndex(
+    slab_s * const psSlab
+) {
+    void * pvLink = NULL;
+    size_t zPageNum = 0;
+    unsigned int shiftDeg = 0;
+
+    for ( pvLink = psSlab->pvPages; NULL != pvLink; pvLink = *(void **)pvLink )
+    {
+        ++zPageNum;
+    }
+
+    // ? room for twice the pages, so the next ones are put in place without a new block
+    shiftDeg = _poolComputeShiftDegree( sizeof(node_s) + 2 * ( zPageNum + 1 ) * sizeof(char *) );
+    psSlab->apIndex = ( 0 == shiftDeg ) ? ( NULL ) : (char **)_poolAllocChain(psSlab->psPool, shiftDeg) ;
+    if ( NULL == psSlab->apIndex )
+    {
+        return;
+    }
+
+    for ( psSlab->zIndex = 0, pvLink = psSlab->pvPages; NULL != pvLink; pvLink = *(void **)pvLink )
+    {
+        psSlab->apIndex[ psSlab->zIndex++ ] = (char *)pvLink;
+    }
+    qsort(psSlab->apIndex, psSlab->zIndex, sizeof(char *), _poolComparePage);
+}
+
+static
+void
+_poolSlabInsert(
+    slab_s * const psSlab,
+    char * const pPage
+) {
+    node_s const * psNode = NULL;
+    size_t zPos = 0;
+
+    if ( NULL == psSlab->apIndex )
+    {
+        return;
+    }
+
+    // ? a full index is dropped, the next erase makes a larger one
+    psNode = (node_s const *)psSlab->apIndex - 1;
+    if ( ( psSlab->zIndex + 1 ) * sizeof(char *) > POOL_BLOCK(psNode->shiftDeg) - sizeof(node_s) )
+    {
+        _poolEraseChain(psSlab->psPool, psSlab->apIndex);
+        psSlab->apIndex = NULL;
+        psSlab->zIndex = 0;
+        return;
+    }
+
+    zPos = _poolSlabFind(psSlab->apIndex, psSlab->zIndex, pPage);
+    memmove(psSlab->apIndex + zPos + 1, psSlab->apIndex + zPos, ( psSlab->zIndex - zPos ) * sizeof(char *));
+    psSlab->apIndex[ zPos ] = pPage;
+    ++psSlab->zIndex;
+}
+
+static
+size_t
+_poolSlabFind(
+    char * const * const apPage,
+    const size_t zPageNum,
+    char const * const pTarget
+) {
+    size_t zLow = 0;
+    size_t zNum = zPageNum;
+    size_t zHalf = 0;
+
+    if ( 0 == zNum )
+    {
+        return 0;
+    }
+
+    // ? the number of pages which start in front of the target, so the last of them may hold it
+    // ? the halving has no branch on the data, an erase hits a random page and would mispredict every step
+    while ( zNum > 1 )
+    {
+        zHalf = zNum / 2;
+        zLow = ( apPage[ zLow + zHalf - 1 ] < pTarget ) ? ( zLow + zHalf ) : ( zLow ) ;
+        zNum -= zHalf;
+    }
+
+    return zLow + ( apPage[ zLow ] < pTarget );
+}
+
+static
+node_s *
+_poolCheckBlock(
+    pool_s const * const psRefs,
+    void const * const pvTarget
+) {
+    node_s * psNode = NULL;
+
+    // ? a stored pointer is bounded before its header is read, and may not lead to a shim
+    if ( (char const *)pvTarget <= (char const *)psRefs || (char const *)pvTarget >= (char const *)psRefs->psInfo.psBoundary ||
+        0 != ( (uintptr_t)pvTarget & ( sizeof(node_s) - 1 ) ) )
+    {
+        return NULL;
+    }
+
+    psNode = _poolSearch(psRefs, pvTarget);
+    return ( NULL != psNode && psNode + 1 == pvTarget ) ? ( psNode ) : ( NULL ) ;
+}
+
+static
+int
+_poolComparePage(
+    void const * pvLeft,
+    void const * pvRight
+) {
+    char const * const pLeft = *(char * const *)pvLeft;
+    char const * const pRight = *(char * const *)pvRight;
+
+    return ( pLeft > pRight ) - ( pLeft < pRight );
+}
+
+static
+file_s *
+_poolFileOf(
+    pool_s const * const psRefs
+) {
+    return (file_s *)psRefs - 1;
+}
+
+static
+local_s *
+_poolLocalOf(
+    pool_s const * const psRefs
+) {
+    // ? other processes may map the same file, so the state of this one stays in the private page in front of the file
+    return ( 0 == ( POOL_FLAG_FILE & psRefs->psInfo.uFlags ) ) ?
+        ( (local_s *)&psRefs->psInfo.sLocal ) :
+        ( (local_s *)_poolFileOf(psRefs) - 1 ) ;
+}
+
+static
+void
+_poolCount(
+    pool_s const * const psRefs,
+    size_t * const azUsed,
+    size_t * const azFree
+) {
+    node_s const * psNode = NULL;
+    size_t zOffset = 0;
+
+    for ( zOffset = POOL_BLOCK(psRefs->psHead.shiftDeg); zOffset < psRefs->psInfo.zFrontier; zOffset += POOL_BLOCK(psNode->shiftDeg) )
+    {
+        psNode = _poolNodeAt(psRefs, zOffset);
+        if ( 0 != psNode->headDiff )
+        {
+            ++azUsed[ psNode->shiftDeg - POOL_DEGREE_MIN ];
+        }
+        else
+        {
+            ++azFree[ psNode->shiftDeg - POOL_DEGREE_MIN ];
+        }
+    }
 }
@@ -6,27 +6,131 @@ extern "C" {
 #endif /* __cplusplus */
 
 #include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define POOL_STATS_DEGREE_NUM ( 27 )
+
+typedef enum { PMError = -1, PMSegregate, PMBuddy } pool_mode_e;
+
+typedef enum { PFNone = 0, PFPopulate = 1 << 0, PFHugePage = 1 << 1, PFPrivate = 1 << 2 } pool_flag_e;
 
 typedef struct pool_s pool_s;
 
+typedef struct slab_s slab_s;
+
+typedef uint32_t pool_handle_t; /* 0 is never a handle */
+
+/* azUsed and azFree count the blocks of ( 16 << idx ) bytes, blocks parked in thread caches are used */
+typedef struct {
+    size_t zTotal;
+    size_t zUsage;
+    size_t zLive; /* bytes of the blocks handed out, zUsage adds the region heads */
+    size_t zPeak; /* high-water mark of zLive */
+    size_t zLargest; /* largest block poolAlloc hands out without mapping a region */
+    size_t zAllocs;
+    size_t zErases;
+    size_t zFails;
+    unsigned int uFragment;
+    unsigned int uRegions;
+    size_t azUsed[ POOL_STATS_DEGREE_NUM ];
+    size_t azFree[ POOL_STATS_DEGREE_NUM ];
+} pool_stats_s;
+
+typedef struct {
+    pool_s * psRegion;
+    size_t zFrontier;
+    pool_s * psOuter;
+    size_t zOuter;
+    void * pvSlabs; /* slabs as they were, kept in a block in front of the checkpoint */
+} pool_mark_s;
+
 pool_s *
 poolFormat(
     void * const pvBuffer,
     const size_t zBufferSize
 );
 
+pool_s *
+poolFormatMode(
+    void * const pvBuffer,
+    const size_t zBufferSize,
+    const pool_mode_e eMode
+);
+
+pool_s *
+poolMake(
+    const size_t zRegionSize,
+    const pool_mode_e eMode,
+    const unsigned int uFlags
+);
+
+/**
+ * maps a pool kept in a file, an empty file is formatted with zFileSize bytes and eMode
+ *  - the file is mapped back at the same address, so the payload may hold pointers into the pool, but not to code
+ *  - PFPrivate maps an existing file copy-on-write, so processes share its pages and never change the file
+ *  - an existing file is refused unless its blocks, free lists and slabs check out
+ *  - a file made by a call which fails is removed again, an empty file which was there is kept
+ */
+pool_s *
+poolOpen(
+    char const * const pPath,
+    const size_t zFileSize,
+    const pool_mode_e eMode,
+    const unsigned int uFlags
+);
+
+void *
+poolRoot(
+    pool_s const * const psRefs
+);
+
+pool_s *
+poolRootChange(
+    pool_s * const psRefs,
+    void * const pvRoot
+);
+
+/* no other thread may use the pool any more, their caches are freed with it even if the threads go on */
+void
+poolFree(
+    void * pvRefs
+);
+
+/* lets several threads use the pool, small blocks go through a cache per thread, poolRelease hands them back and poolReset drops them */
+pool_s *
+poolShare(
+    pool_s * const psRefs
+);
+
 void *
 poolAlloc(
     pool_s * const psRefs,
     const size_t zAllocSize
 );
 
+/* zAlign is a power of two up to 64, the block is released by poolErase as usual */
+void *
+poolAllocAligned(
+    pool_s * const psRefs,
+    const size_t zAllocSize,
+    const size_t zAlign
+);
+
 pool_s *
 poolErase(
     pool_s * const psRefs,
     void * const pvTarget
 );
 
+/* grows or shrinks the block in place when it can, otherwise moves it keeping its alignment up to 64; on failure the old block is kept */
+void *
+poolResize(
+    pool_s * const psRefs,
+    void * const pvTarget,
+    const size_t zSize
+);
+
 size_t
 poolSpace(
     pool_s const * const psRefs,
@@ -43,6 +147,101 @@ poolUsage(
     pool_s const * const psRefs
 );
 
+pool_mode_e
+poolMode(
+    pool_s const * const psRefs
+);
+
+/* per-mille of the free bytes that cannot be handed out as one block */
+unsigned int
+poolFragment(
+    pool_s const * const psRefs
+);
+
+pool_s *
+poolReset(
+    pool_s * const psRefs
+);
+
+/* poolRelease drops every block made after the checkpoint, checkpoints nest and are released innermost first */
+pool_s *
+poolMark(
+    pool_s * const psRefs,
+    pool_mark_s * const psMark
+);
+
+pool_s *
+poolRelease(
+    pool_s * const psRefs,
+    pool_mark_s const * const psMark
+);
+
+/* a handle block may be moved by poolCompact, so its address is only good until then, erase it by the handle */
+pool_handle_t
+poolHandleAlloc(
+    pool_s * const psRefs,
+    const size_t zAllocSize
+);
+
+void *
+poolHandleAccess(
+    pool_s const * const psRefs,
+    const pool_handle_t uHandle
+);
+
+pool_s *
+poolHandleErase(
+    pool_s * const psRefs,
+    const pool_handle_t uHandle
+);
+
+/* slides the handle blocks together, segregated pools only and not under a checkpoint */
+pool_s *
+poolCompact(
+    pool_s * const psRefs
+);
+
+pool_stats_s *
+poolStats(
+    pool_s const * const psRefs,
+    pool_stats_s * const psStats
+);
+
+void
+poolDump(
+    pool_s const * const psRefs,
+    FILE * const psFile
+);
+
+/* slabs of the same object size are shared within a pool, each slabMake is paired with a slabFree */
+slab_s *
+slabMake(
+    pool_s * const psPool,
+    const size_t zObjSize
+);
+
+void
+slabFree(
+    void * pvRefs
+);
+
+void *
+slabAlloc(
+    slab_s * const psRefs
+);
+
+/* returns NULL for an object the slab did not hand out, and in debug builds for one erased already */
+slab_s *
+slabErase(
+    slab_s * const psRefs,
+    void * const pvTarget
+);
+
+size_t
+slabSize(
+    slab_s const * const psRefs
+);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
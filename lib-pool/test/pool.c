@@ -0,0 +1,409 @@
+#include "pool.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+
+#define TEST_BUFFER ( (size_t)64 << 10 )
+#define TEST_BLOCKS ( 512 )
+#define TEST_FILE "/tmp/lib-pool-test.pool"
+
+/* counts the failed checks, a check names its line and goes on so one run shows every failure */
+#define TEST_CHECK(cond) _testCheck( (cond), __LINE__, #cond )
+
+static size_t zFailed = 0;
+static size_t zChecked = 0;
+
+static
+void
+_testCheck(
+    const bool bPassed,
+    const int iLine,
+    char const * const pText
+) {
+    ++zChecked;
+    if ( false == bPassed )
+    {
+        ++zFailed;
+        fprintf(stderr, "test/pool.c:%d: %s\n", iLine, pText);
+    }
+}
+
+static
+size_t
+_testLargest(
+    pool_s const * const psPool
+) {
+    pool_stats_s sStats;
+
+    return ( NULL == poolStats(psPool, &sStats) ) ? ( 0 ) : ( sStats.zLargest ) ;
+}
+
+static
+unsigned int
+_testRegions(
+    pool_s const * const psPool
+) {
+    pool_stats_s sStats;
+
+    return ( NULL == poolStats(psPool, &sStats) ) ? ( 0 ) : ( sStats.uRegions ) ;
+}
+
+static
+void
+_testCoalesce(
+    const pool_mode_e eMode
+) {
+    void * const pvBuffer = malloc(TEST_BUFFER);
+    pool_s * const psPool = poolFormatMode(pvBuffer, TEST_BUFFER, eMode);
+    void ** const apBlock = (void **)malloc(TEST_BUFFER / 16 * sizeof(void *));
+    const size_t zEmpty = _testLargest(psPool);
+    const size_t zUsage = poolUsage(psPool);
+    size_t zCount = 0;
+    size_t idx = 0;
+
+    // ? fill the pool with small blocks, a formatted pool does not grow
+    for ( zCount = 0; zCount < TEST_BUFFER / 16; ++zCount )
+    {
+        apBlock[ zCount ] = poolAlloc(psPool, 8);
+        if ( NULL == apBlock[ zCount ] )
+        {
+            break;
+        }
+    }
+    TEST_CHECK( 0 < zCount && zCount < TEST_BUFFER / 16 );
+
+    for ( idx = 0; idx < zCount; idx += 2 )
+    {
+        TEST_CHECK( psPool == poolErase(psPool, apBlock[ idx ]) );
+    }
+    TEST_CHECK( NULL == poolAlloc(psPool, 64) ); /* every other block is still in use */
+
+    for ( idx = 1; idx < zCount; idx += 2 )
+    {
+        TEST_CHECK( psPool == poolErase(psPool, apBlock[ idx ]) );
+    }
+
+    // ? the neighbours merged back, so a block of half the pool fits again
+    apBlock[ 0 ] = poolAlloc(psPool, zEmpty / 2);
+    TEST_CHECK( NULL != apBlock[ 0 ] );
+    TEST_CHECK( psPool == poolErase(psPool, apBlock[ 0 ]) );
+    TEST_CHECK( NULL == poolErase(psPool, apBlock[ 0 ]) );
+    TEST_CHECK( zUsage == poolUsage(psPool) );
+
+    poolFree(psPool);
+    free(apBlock);
+    free(pvBuffer);
+}
+
+static
+void
+_testMark(
+    const pool_mode_e eMode
+) {
+    pool_s * const psPool = poolMake(TEST_BUFFER, eMode, PFNone);
+    slab_s * const psSlab = slabMake(psPool, 24);
+    char * apOld[ 8 ];
+    char * apNew[ 8 ];
+    void * pvObject = NULL;
+    void * pvKept = NULL;
+    pool_mark_s sOuter;
+    pool_mark_s sInner;
+    size_t zUsage = 0;
+    unsigned int uRegions = 0;
+    size_t idx = 0;
+
+    for ( idx = 0; idx < 8; ++idx )
+    {
+        apOld[ idx ] = (char *)poolAlloc(psPool, 100);
+        memset(apOld[ idx ], (int)idx, 100);
+    }
+    pvKept = slabAlloc(psSlab);
+    pvObject = slabAlloc(psSlab);
+    TEST_CHECK( psSlab == slabErase(psSlab, pvObject) );
+
+    zUsage = poolUsage(psPool);
+    uRegions = _testRegions(psPool);
+    TEST_CHECK( psPool == poolMark(psPool, &sOuter) );
+
+    // ? blocks freed in front of the checkpoint must not hide the free ones behind it
+    for ( idx = 0; idx < 8; ++idx )
+    {
+        apNew[ idx ] = (char *)poolAlloc(psPool, 100);
+    }
+    pvObject = poolAlloc(psPool, 100);
+    for ( idx = 0; idx < 8; ++idx )
+    {
+        poolErase(psPool, apNew[ idx ]);
+    }
+    poolErase(psPool, apOld[ 0 ]);
+    poolErase(psPool, apOld[ 2 ]);
+    for ( idx = 0; idx < 8; ++idx )
+    {
+        apNew[ idx ] = (char *)poolAlloc(psPool, 100);
+        TEST_CHECK( NULL != apNew[ idx ] && apNew[ idx ] < (char *)pvObject );
+    }
+    TEST_CHECK( uRegions == _testRegions(psPool) );
+
+    // ? a nested checkpoint takes back only what was made after it
+    TEST_CHECK( psPool == poolMark(psPool, &sInner) );
+    TEST_CHECK( NULL != poolAlloc(psPool, 3000) );
+    TEST_CHECK( NULL != slabAlloc(psSlab) );
+    TEST_CHECK( NULL == poolRelease(psPool, &sOuter) ); /* the inner one goes first */
+    TEST_CHECK( psPool == poolRelease(psPool, &sInner) );
+    TEST_CHECK( psPool == poolRelease(psPool, &sOuter) );
+
+    // ? the blocks made before the checkpoint kept their bytes, the freed ones stay free
+    for ( idx = 1; idx < 8; idx += ( 1 == idx ) ? ( 2 ) : ( 1 ) )
+    {
+        TEST_CHECK( (char)idx == apOld[ idx ][ 0 ] && (char)idx == apOld[ idx ][ 99 ] );
+    }
+    TEST_CHECK( zUsage - poolSpace(psPool, apOld[ 1 ]) * 2 <= poolUsage(psPool) && poolUsage(psPool) < zUsage );
+
+    // ? the slab hands out the object that was free at the checkpoint again
+    TEST_CHECK( NULL == slabErase(psSlab, (char *)pvKept + 8) );
+    pvObject = slabAlloc(psSlab);
+    TEST_CHECK( NULL != pvObject && pvKept != pvObject );
+
+    TEST_CHECK( NULL == poolErase(psPool, apOld[ 0 ]) );
+    slabFree(psSlab);
+    poolFree(psPool);
+}
+
+static
+void
+_testResize(
+    const pool_mode_e eMode
+) {
+    pool_s * const psPool = poolMake(TEST_BUFFER, eMode, PFNone);
+    pool_handle_t uHandle = 0;
+    unsigned char * pBlock = NULL;
+    unsigned char * pWall = NULL;
+    size_t idx = 0;
+    bool bSame = true;
+
+    // ? grow in place, then against a neighbour so the block has to move
+    pBlock = (unsigned char *)poolAlloc(psPool, 40);
+    for ( idx = 0; idx < 40; ++idx )
+    {
+        pBlock[ idx ] = (unsigned char)idx;
+    }
+    pWall = (unsigned char *)poolAlloc(psPool, 40);
+    pBlock = (unsigned char *)poolResize(psPool, pBlock, 1000);
+    TEST_CHECK( NULL != pBlock && 1000 <= poolSpace(psPool, pBlock) );
+    for ( idx = 0; NULL != pBlock && idx < 40; ++idx )
+    {
+        bSame = bSame && (unsigned char)idx == pBlock[ idx ];
+    }
+    TEST_CHECK( bSame );
+
+    pBlock = (unsigned char *)poolResize(psPool, pBlock, 20);
+    TEST_CHECK( NULL != pBlock && 20 <= poolSpace(psPool, pBlock) && 19 == pBlock[ 19 ] );
+    TEST_CHECK( NULL == poolResize(psPool, pBlock, 0) );
+    poolErase(psPool, pWall);
+
+    // ? an aligned block keeps its alignment when it moves
+    pBlock = (unsigned char *)poolAllocAligned(psPool, 50, 64);
+    pWall = (unsigned char *)poolAlloc(psPool, 40);
+    TEST_CHECK( NULL != pBlock && 0 == ( (uintptr_t)pBlock & 63 ) );
+    memset(pBlock, 0x5A, 50);
+    pBlock = (unsigned char *)poolResize(psPool, pBlock, 5000);
+    TEST_CHECK( NULL != pBlock && 0 == ( (uintptr_t)pBlock & 63 ) && 0x5A == pBlock[ 49 ] );
+    TEST_CHECK( psPool == poolErase(psPool, pBlock) );
+
+    // ? a handle block keeps its handle when it moves
+    uHandle = poolHandleAlloc(psPool, 40);
+    pBlock = (unsigned char *)poolHandleAccess(psPool, uHandle);
+    TEST_CHECK( NULL != pBlock );
+    memset(pBlock, 0x33, 40);
+    pWall = (unsigned char *)poolAlloc(psPool, 40);
+    pBlock = (unsigned char *)poolResize(psPool, pBlock, 3000);
+    TEST_CHECK( NULL != pBlock && pBlock == poolHandleAccess(psPool, uHandle) && 0x33 == pBlock[ 39 ] );
+    TEST_CHECK( psPool == poolHandleErase(psPool, uHandle) );
+
+    poolFree(psPool);
+}
+
+static
+void
+_testFile(
+    const pool_mode_e eMode
+) {
+    pool_s * psPool = NULL;
+    slab_s * psSlab = NULL;
+    char * pRoot = NULL;
+    char ** apList = NULL;
+    FILE * psFile = NULL;
+    size_t idx = 0;
+
+    // ? a failed open does not leave a file behind
+    unlink(TEST_FILE);
+    TEST_CHECK( NULL == poolOpen(TEST_FILE, 0, eMode, PFNone) );
+    TEST_CHECK( 0 != access(TEST_FILE, F_OK) );
+
+    psPool = poolOpen(TEST_FILE, (size_t)1 << 20, eMode, PFNone);
+    TEST_CHECK( NULL != psPool );
+    if ( NULL == psPool )
+    {
+        return;
+    }
+
+    // ? the payload may point into the pool, the file comes back at the same address
+    apList = (char **)poolAlloc(psPool, 16 * sizeof(char *));
+    for ( idx = 0; idx < 16; ++idx )
+    {
+        apList[ idx ] = (char *)poolAlloc(psPool, 32);
+        snprintf(apList[ idx ], 32, "entry %zu", idx);
+    }
+    poolErase(psPool, apList[ 3 ]);
+    apList[ 3 ] = NULL;
+    psSlab = slabMake(psPool, 48);
+    slabErase(psSlab, slabAlloc(psSlab));
+    TEST_CHECK( psPool == poolRootChange(psPool, apList) );
+    poolShare(psPool);
+    poolFree(psPool);
+
+    psPool = poolOpen(TEST_FILE, 0, eMode, PFNone);
+    TEST_CHECK( NULL != psPool );
+    apList = ( NULL == psPool ) ? ( NULL ) : (char **)poolRoot(psPool);
+    TEST_CHECK( NULL != apList );
+    for ( idx = 0; NULL != apList && idx < 16; ++idx )
+    {
+        pRoot = ( 3 == idx ) ? ( NULL ) : ( apList[ idx ] ) ;
+        TEST_CHECK( 3 == idx || ( NULL != pRoot && 0 == strncmp(pRoot, "entry ", 6) && (size_t)atoi(pRoot + 6) == idx ) );
+    }
+    TEST_CHECK( NULL != poolAlloc(psPool, 100) );
+    poolFree(psPool);
+
+    // ? a damaged file is refused
+    psFile = fopen(TEST_FILE, "r+b");
+    TEST_CHECK( NULL != psFile );
+    if ( NULL != psFile )
+    {
+        fseek(psFile, 64 + 256, SEEK_SET); /* the first block header behind the file and pool headers */
+        fwrite("\xFF\xFF\xFF\xFF", 1, 4, psFile);
+        fclose(psFile);
+        TEST_CHECK( NULL == poolOpen(TEST_FILE, 0, eMode, PFNone) );
+    }
+
+    unlink(TEST_FILE);
+}
+
+static
+size_t
+_testSpan(
+    pool_s * const psPool,
+    pool_handle_t const * const auHandle,
+    const size_t zCount
+) {
+    char const * pLow = NULL;
+    char const * pHigh = NULL;
+    size_t idx = 0;
+
+    for ( idx = 1; idx < zCount; idx += 2 )
+    {
+        char const * const pBlock = (char const *)poolHandleAccess(psPool, auHandle[ idx ]);
+        pLow = ( NULL == pLow || pBlock < pLow ) ? ( pBlock ) : ( pLow ) ;
+        pHigh = ( NULL == pHigh || pBlock > pHigh ) ? ( pBlock ) : ( pHigh ) ;
+    }
+
+    return (size_t)( pHigh - pLow );
+}
+
+static
+void
+_testCompact(
+    void
+) {
+    pool_s * const psPool = poolMake(TEST_BUFFER, PMSegregate, PFNone);
+    pool_handle_t auHandle[ 64 ];
+    pool_mark_s sMark;
+    size_t zSpan = 0;
+    size_t zUsage = 0;
+    size_t idx = 0;
+    bool bSame = true;
+
+    for ( idx = 0; idx < 64; ++idx )
+    {
+        auHandle[ idx ] = poolHandleAlloc(psPool, 100);
+        memset(poolHandleAccess(psPool, auHandle[ idx ]), (int)idx, 100);
+    }
+
+    for ( idx = 0; idx < 64; idx += 2 )
+    {
+        TEST_CHECK( psPool == poolHandleErase(psPool, auHandle[ idx ]) );
+    }
+    TEST_CHECK( NULL == poolHandleAccess(psPool, auHandle[ 0 ]) );
+
+    // ? not under a checkpoint
+    poolMark(psPool, &sMark);
+    TEST_CHECK( NULL == poolCompact(psPool) );
+    poolRelease(psPool, &sMark);
+
+    // ? the live blocks close the gaps between them, and keep their bytes
+    zSpan = _testSpan(psPool, auHandle, 64);
+    zUsage = poolUsage(psPool);
+    TEST_CHECK( psPool == poolCompact(psPool) );
+    TEST_CHECK( _testSpan(psPool, auHandle, 64) * 2 <= zSpan && zUsage == poolUsage(psPool) );
+
+    for ( idx = 1; idx < 64; idx += 2 )
+    {
+        unsigned char const * const pBlock = (unsigned char const *)poolHandleAccess(psPool, auHandle[ idx ]);
+        bSame = bSame && NULL != pBlock && (unsigned char)idx == pBlock[ 0 ] && (unsigned char)idx == pBlock[ 99 ];
+    }
+    TEST_CHECK( bSame );
+
+    poolFree(psPool);
+}
+
+static
+void
+_testShare(
+    void
+) {
+    pool_s * const psPool = poolShare(poolMake(TEST_BUFFER, PMSegregate, PFNone));
+    slab_s * const psSlab = slabMake(psPool, 16);
+    slab_s * const psOther = slabMake(psPool, 32);
+    void * pvBlock = poolAlloc(psPool, 24);
+    void * pvObject = slabAlloc(psSlab);
+    char aLocal[ 32 ];
+
+    // ? a block parked in the cache of the thread is not erased twice
+    TEST_CHECK( psPool == poolErase(psPool, pvBlock) );
+    TEST_CHECK( NULL == poolErase(psPool, pvBlock) );
+
+    // ? a slab takes back only its own objects, and each of them once
+    TEST_CHECK( NULL == slabErase(psSlab, aLocal) );
+    TEST_CHECK( NULL == slabErase(psOther, pvObject) );
+    TEST_CHECK( NULL == slabErase(psSlab, (char *)pvObject + 16) ); /* past the carved part */
+    TEST_CHECK( psSlab == slabErase(psSlab, pvObject) );
+#ifndef NDEBUG
+    TEST_CHECK( NULL == slabErase(psSlab, pvObject) );
+#endif /* NDEBUG */
+    TEST_CHECK( pvObject == slabAlloc(psSlab) );
+
+    slabFree(psOther);
+    slabFree(psSlab);
+    poolFree(psPool);
+}
+
+int
+main(
+    void
+) {
+    _testCoalesce(PMSegregate);
+    _testCoalesce(PMBuddy);
+    _testMark(PMSegregate);
+    _testMark(PMBuddy);
+    _testResize(PMSegregate);
+    _testResize(PMBuddy);
+    _testFile(PMSegregate);
+    _testFile(PMBuddy);
+    _testCompact();
+    _testShare();
+
+    printf("pool: %zu of %zu checks failed\n", zFailed, zChecked);
+    return ( 0 == zFailed ) ? ( 0 ) : ( 1 ) ;
+}
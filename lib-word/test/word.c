@@ -0,0 +1,283 @@
+#include "../word.c"
+
+#define TEST_LENGTH ( 200 )
+#define TEST_ROUNDS ( 200000 )
+
+/* counts the failed checks, a check names its line and goes on so one run shows every failure */
+#define TEST_CHECK(cond) _testCheck( (cond), __LINE__, #cond )
+
+static size_t zFailed = 0;
+static size_t zChecked = 0;
+static uint32_t uSeed = 2463534242u;
+
+static
+void
+_testCheck(
+    const bool bPassed,
+    const int iLine,
+    char const * const pText
+) {
+    ++zChecked;
+    if ( false == bPassed )
+    {
+        ++zFailed;
+        fprintf(stderr, "test/word.c:%d: %s\n", iLine, pText);
+    }
+}
+
+static
+uint32_t
+_testRandom(
+    void
+) {
+    uSeed ^= uSeed << 13;
+    uSeed ^= uSeed >> 17;
+    uSeed ^= uSeed << 5;
+    return uSeed;
+}
+
+static
+size_t
+_testEncode(
+    unsigned char * const pTarget,
+    const uint32_t uPoint
+) {
+    // ? encodes surrogates and points past U+10FFFF as well, so the invalid ones can be made too
+    if ( uPoint < 0x80 )
+    {
+        pTarget[ 0 ] = (unsigned char)uPoint;
+        return 1;
+    }
+    if ( uPoint < 0x800 )
+    {
+        pTarget[ 0 ] = (unsigned char)( 0xC0 | ( uPoint >> 6 ) );
+        pTarget[ 1 ] = (unsigned char)( 0x80 | ( uPoint & 0x3F ) );
+        return 2;
+    }
+    if ( uPoint < 0x10000 )
+    {
+        pTarget[ 0 ] = (unsigned char)( 0xE0 | ( uPoint >> 12 ) );
+        pTarget[ 1 ] = (unsigned char)( 0x80 | ( ( uPoint >> 6 ) & 0x3F ) );
+        pTarget[ 2 ] = (unsigned char)( 0x80 | ( uPoint & 0x3F ) );
+        return 3;
+    }
+    pTarget[ 0 ] = (unsigned char)( 0xF0 | ( ( uPoint >> 18 ) & 0x07 ) );
+    pTarget[ 1 ] = (unsigned char)( 0x80 | ( ( uPoint >> 12 ) & 0x3F ) );
+    pTarget[ 2 ] = (unsigned char)( 0x80 | ( ( uPoint >> 6 ) & 0x3F ) );
+    pTarget[ 3 ] = (unsigned char)( 0x80 | ( uPoint & 0x3F ) );
+    return 4;
+}
+
+static
+bool
+_testValid(
+    unsigned char const * const pSource,
+    const size_t zCount,
+    size_t * const pzPoints
+) {
+    size_t zOffset = 0;
+    size_t zWidth = 0;
+    unsigned char uLow = 0x80;
+    unsigned char uHigh = 0xBF;
+    size_t idx = 0;
+
+    // ? the table of well-formed sequences from the Unicode standard, the second byte carries the narrow ranges
+    for ( *pzPoints = 0; zOffset < zCount; zOffset += zWidth, ++*pzPoints )
+    {
+        const unsigned char uLead = pSource[ zOffset ];
+
+        uLow = 0x80;
+        uHigh = 0xBF;
+        if ( uLead <= 0x7F )
+        {
+            zWidth = 1;
+        }
+        else if ( uLead >= 0xC2 && uLead <= 0xDF )
+        {
+            zWidth = 2;
+        }
+        else if ( uLead >= 0xE0 && uLead <= 0xEF )
+        {
+            zWidth = 3;
+            uLow = ( 0xE0 == uLead ) ? ( 0xA0 ) : ( 0x80 ) ;
+            uHigh = ( 0xED == uLead ) ? ( 0x9F ) : ( 0xBF ) ;
+        }
+        else if ( uLead >= 0xF0 && uLead <= 0xF4 )
+        {
+            zWidth = 4;
+            uLow = ( 0xF0 == uLead ) ? ( 0x90 ) : ( 0x80 ) ;
+            uHigh = ( 0xF4 == uLead ) ? ( 0x8F ) : ( 0xBF ) ;
+        }
+        else
+        {
+            return false;
+        }
+
+        if ( zWidth > zCount - zOffset )
+        {
+            return false;
+        }
+
+        for ( idx = 1; idx < zWidth; ++idx )
+        {
+            const unsigned char uByte = pSource[ zOffset + idx ];
+            if ( ( 1 == idx && ( uByte < uLow || uByte > uHigh ) ) || 0x80 != ( 0xC0 & uByte ) )
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+static
+void
+_testCompare(
+    unsigned char const * const pSource,
+    const size_t zCount
+) {
+    const word_view_s sView = { .pString = (char const *)pSource, .zLength = zCount };
+    size_t zPoints = 0;
+    const bool bValid = _testValid(pSource, zCount, &zPoints);
+#ifdef WORD_UTF8_SIMD
+    size_t zDone = 0;
+#endif
+
+    TEST_CHECK( bValid == ( zCount == _wordUtf8Check(pSource, zCount) ) );
+    TEST_CHECK( bValid == wordUtf8Valid(sView) );
+    TEST_CHECK( !bValid || zPoints == wordUtf8Count(sView) );
+
+#ifdef WORD_UTF8_SIMD
+    // ? the vector check alone, whatever the cpu picks for wordUtf8Valid
+    if ( __builtin_cpu_supports("ssse3") )
+    {
+        zDone = _wordUtf8CheckSimd(pSource, zCount);
+        TEST_CHECK( bValid == ( SIZE_MAX != zDone && zCount == zDone + _wordUtf8Check(pSource + zDone, zCount - zDone) ) );
+    }
+#endif
+}
+
+static
+size_t
+_testText(
+    unsigned char * const pTarget,
+    const size_t zLength
+) {
+    static const uint32_t auEdge[] = {
+        0x00, 0x7F, 0x80, 0x7FF, 0x800, 0xFFF, 0x1000, 0xD7FF, 0xD800, 0xDFFF, 0xE000,
+        0xFFFD, 0xFFFF, 0x10000, 0x3FFFF, 0x40000, 0xFFFFF, 0x100000, 0x10FFFF, 0x110000, 0x1FFFFF
+    };
+    size_t zOffset = 0;
+    uint32_t uPoint = 0;
+
+    // ? mostly ascii with runs of wider codepoints, so the vector loop sees both of its paths
+    while ( zOffset + 4 <= zLength )
+    {
+        switch ( _testRandom() % 8 )
+        {
+            case 0: case 1: case 2:
+                uPoint = _testRandom() % 0x80;
+                break;
+            case 3:
+                uPoint = 0x80 + _testRandom() % ( 0x800 - 0x80 );
+                break;
+            case 4:
+                uPoint = 0x800 + _testRandom() % ( 0x10000 - 0x800 );
+                uPoint = ( uPoint >= 0xD800 && uPoint <= 0xDFFF ) ? ( uPoint - 0x800 ) : ( uPoint ) ;
+                break;
+            case 5:
+                uPoint = 0x10000 + _testRandom() % ( 0x110000 - 0x10000 );
+                break;
+            default:
+                uPoint = auEdge[ _testRandom() % ( sizeof(auEdge) / sizeof(auEdge[ 0 ]) ) ];
+                uPoint = ( uPoint >= 0xD800 && uPoint <= 0xDFFF ) || uPoint > 0x10FFFF ? ( 0xFFFD ) : ( uPoint ) ;
+                break;
+        }
+        zOffset += _testEncode(pTarget + zOffset, uPoint);
+    }
+
+    return zOffset;
+}
+
+static
+void
+_testEdges(
+    void
+) {
+    static const char * const apBad[] = {
+        "\xC0\x80", "\xC1\xBF", "\xE0\x80\x80", "\xE0\x9F\xBF", "\xED\xA0\x80", "\xED\xBF\xBF",
+        "\xF0\x80\x80\x80", "\xF0\x8F\xBF\xBF", "\xF4\x90\x80\x80", "\xF5\x80\x80\x80", "\xFF",
+        "\x80", "\xBF", "\xC2", "\xE1\x80", "\xF1\x80\x80", "\xC2\xC2", "\xE1\x80\xC0"
+    };
+    static const char * const apGood[] = {
+        "\xC2\x80", "\xDF\xBF", "\xE0\xA0\x80", "\xED\x9F\xBF", "\xEE\x80\x80", "\xEF\xBF\xBF",
+        "\xF0\x90\x80\x80", "\xF4\x8F\xBF\xBF", "\x7F"
+    };
+    unsigned char aBuffer[ 64 ];
+    size_t zWidth = 0;
+    size_t zAt = 0;
+    size_t idx = 0;
+
+    // ? every sequence at every offset of a 48 byte ascii run, so it crosses each block boundary
+    for ( idx = 0; idx < sizeof(apBad) / sizeof(apBad[ 0 ]) + sizeof(apGood) / sizeof(apGood[ 0 ]); ++idx )
+    {
+        char const * const pSequence = ( idx < sizeof(apBad) / sizeof(apBad[ 0 ]) ) ? ( apBad[ idx ] ) : ( apGood[ idx - sizeof(apBad) / sizeof(apBad[ 0 ]) ] ) ;
+
+        zWidth = strlen(pSequence);
+        for ( zAt = 0; zAt + zWidth <= 48; ++zAt )
+        {
+            memset(aBuffer, 'a', 48);
+            memcpy(aBuffer + zAt, pSequence, zWidth);
+            _testCompare(aBuffer, 48);
+            _testCompare(aBuffer, zAt + zWidth); /* the sequence ends the text */
+            _testCompare(aBuffer, zAt + zWidth - 1); /* and is cut by its end */
+        }
+    }
+
+    _testCompare((unsigned char const *)"", 0);
+    TEST_CHECK( false == wordUtf8Valid(wordViewLen(NULL, 0)) );
+}
+
+int
+main(
+    void
+) {
+    unsigned char aBuffer[ TEST_LENGTH + 4 ];
+    size_t zLength = 0;
+    size_t zRound = 0;
+    size_t idx = 0;
+
+    _testEdges();
+
+    for ( zRound = 0; zRound < TEST_ROUNDS; ++zRound )
+    {
+        zLength = _testText(aBuffer, _testRandom() % TEST_LENGTH);
+
+        // ? valid text, then the same text with a few bytes flipped, cut or set at random
+        _testCompare(aBuffer, zLength);
+        switch ( _testRandom() % 4 )
+        {
+            case 0:
+                for ( idx = 0; idx < TEST_LENGTH; ++idx )
+                {
+                    aBuffer[ idx ] = (unsigned char)_testRandom();
+                }
+                zLength = _testRandom() % TEST_LENGTH;
+                break;
+            case 1:
+                zLength = ( 0 == zLength ) ? ( 0 ) : ( _testRandom() % zLength ) ;
+                break;
+            default:
+                for ( idx = 1 + _testRandom() % 2; 0 < zLength && 0 < idx; --idx )
+                {
+                    aBuffer[ _testRandom() % zLength ] ^= (unsigned char)( 1 << ( _testRandom() % 8 ) );
+                }
+                break;
+        }
+        _testCompare(aBuffer, zLength);
+    }
+
+    printf("word: %zu of %zu checks failed\n", zFailed, zChecked);
+    return ( 0 == zFailed ) ? ( 0 ) : ( 1 ) ;
+}
@@ -1,13 +1,72 @@
 #include "word.h"
 
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
+#if defined(__x86_64__) || defined(__i386__)
+#include <emmintrin.h>
+#include <tmmintrin.h>
+#define WORD_UTF8_SIMD ( 1 )
+#endif
+
+#define WORD_INTERN_MIN ( 64 )
+#define WORD_BUILDER_MIN ( 64 )
+#define WORD_INDEX_STEP ( 64 ) /* codepoints between two recorded offsets */
+
+/* one block holds the header and the text, so a short word costs a single small class, a NULL pool means the heap */
 struct word_s {
     pool_s * const psPool;
-    char * pString;
     size_t zLength;
+    uint64_t uHash; /* of the text without the terminator, set once when the word is made */
+    char aString[];
+};
+
+typedef struct {
+    uint64_t uHash;
+    word_s * psWord;
+} slot_s;
+
+/* open addressing with linear probing, the slots are kept at most three quarters full */
+struct word_intern_s {
+    pool_s * const psPool;
+    slot_s * asSlot;
+    size_t zMask;
+    size_t zCount;
 };
 
+/* the text is built right in a word_s block, so wordBuilderFinish hands it off without a copy */
+struct word_builder_s {
+    pool_s * const psPool;
+    word_s * psWord;
+    size_t zCount;
+    size_t zCapacity; /* bytes of text the block holds, the terminator comes on top */
+};
+
+/* azOffset[ i ] is the byte offset of codepoint i * WORD_INDEX_STEP */
+struct word_index_s {
+    pool_s * const psPool;
+    word_s const * psWord;
+    size_t zCount;
+    size_t azOffset[];
+};
+
+static word_s * _wordDup(pool_s * const psPool, char const * const pSource, const size_t zCount);
+static uint64_t _wordHash(char const * const pSource, const size_t zCount);
+static uint64_t _wordMix(const uint64_t uLeft, const uint64_t uRight);
+static uint64_t _wordRead(unsigned char const * const pSource, const size_t zWidth);
+static bool _wordInternGrow(word_intern_s * const psRefs);
+static word_s * _wordBlock(pool_s * const psPool, word_s * const psWord, const size_t zCapacity);
+static bool _wordBuilderReserve(word_builder_s * const psRefs, const size_t zCount);
+static size_t _wordUtf8Check(unsigned char const * const pSource, const size_t zCount);
+#ifdef WORD_UTF8_SIMD
+static size_t _wordUtf8CheckSimd(unsigned char const * const pSource, const size_t zCount);
+#endif
+
+/* public */
 word_s * 
 wordDupAll(
     pool_s * const psPool,
@@ -22,38 +81,35 @@ wordDupLen(
     char const * const pSource,
     const size_t zLength
 ) {
-    word_s * psRefs = 0;
-    
+    char const * pLocation = NULL;
+
     if ( NULL == psPool || NULL == pSource )
     {
         return NULL;
     }
 
-    psRefs = (word_s *)poolAlloc(psPool, sizeof(word_s));
-    if ( NULL == psRefs )
+    if ( 0 == zLength )
     {
-        return NULL;
+        return _wordDup(psPool, pSource, strlen(pSource));
     }
 
-    psRefs->zLength = 1 + strlen(pSource);
-    if ( zLength > 0 && psRefs->zLength > zLength )
-    {
-        psRefs->zLength = zLength;
-    }
+    // ? stop at an earlier terminator, but never read past the bytes asked for
+    pLocation = (char const *)memchr(pSource, '\0', zLength - 1);
+    return _wordDup(psPool, pSource, ( NULL == pLocation ) ? ( zLength - 1 ) : (size_t)( pLocation - pSource ) );
+}
 
-    psRefs->pString = (char *)poolAlloc(psPool, psRefs->zLength);
-    if ( NULL == psRefs->pString )
+word_s * 
+wordDupRange(
+    pool_s * const psPool,
+    char const * const pBegin,
+    char const * const pEnd
+) {
+    if ( NULL == psPool || NULL == pBegin || pEnd < pBegin )
     {
-        poolErase(psPool, psRefs);
         return NULL;
     }
 
-    memcpy(psRefs->pString, pSource, psRefs->zLength - 1);
-    psRefs->pString[ psRefs->zLength - 1 ] = '\0';
-
-    *(void **)&psRefs->psPool = psPool;
-
-    return psRefs;
+    return _wordDup(psPool, pBegin, (size_t)( pEnd - pBegin ));
 }
 
 word_s * 
@@ -70,7 +126,7 @@ wordDupChr(
     }
 
     pLocation = strchr(pSource, endChr);
-    return ( NULL == pLocation ) ? ( NULL ) : wordDupLen(psPool, pSource, 1 + pLocation - pSource) ;
+    return ( NULL == pLocation ) ? ( NULL ) : _wordDup(psPool, pSource, (size_t)( pLocation - pSource )) ;
 }
 
 word_s * 
@@ -87,7 +143,109 @@ wordDupStr(
     }
 
     pLocation = strstr(pSource, pEndStr);
-    return ( NULL == pLocation ) ? ( NULL ) : wordDupLen(psPool, pSource, 1 + pLocation - pSource) ;
+    return ( NULL == pLocation ) ? ( NULL ) : _wordDup(psPool, pSource, (size_t)( pLocation - pSource )) ;
+}
+
+word_s * 
+wordDupView(
+    pool_s * const psPool,
+    const word_view_s sView
+) {
+    if ( NULL == psPool || NULL == sView.pString )
+    {
+        return NULL;
+    }
+
+    return _wordDup(psPool, sView.pString, sView.zLength);
+}
+
+word_view_s 
+wordViewLen(
+    char const * const pSource,
+    const size_t zLength
+) {
+    word_view_s sView = { NULL, 0 };
+    char const * pLocation = NULL;
+
+    if ( NULL == pSource )
+    {
+        return sView;
+    }
+
+    // ? same bounds as wordDupLen, zero takes the whole string
+    pLocation = ( 0 == zLength ) ? ( pSource + strlen(pSource) ) : (char const *)memchr(pSource, '\0', zLength - 1) ;
+    sView.pString = pSource;
+    sView.zLength = ( NULL == pLocation ) ? ( zLength - 1 ) : (size_t)( pLocation - pSource ) ;
+    return sView;
+}
+
+word_view_s 
+wordViewChr(
+    char const * const pSource,
+    const char endChr
+) {
+    word_view_s sView = { NULL, 0 };
+    char const * pLocation = NULL;
+
+    if ( NULL == pSource || NULL == ( pLocation = strchr(pSource, endChr) ) )
+    {
+        return sView;
+    }
+
+    sView.pString = pSource;
+    sView.zLength = (size_t)( pLocation - pSource );
+    return sView;
+}
+
+word_view_s 
+wordViewStr(
+    char const * const pSource,
+    char const * const pEndStr
+) {
+    word_view_s sView = { NULL, 0 };
+    char const * pLocation = NULL;
+
+    if ( NULL == pSource || NULL == ( pLocation = strstr(pSource, pEndStr) ) )
+    {
+        return sView;
+    }
+
+    sView.pString = pSource;
+    sView.zLength = (size_t)( pLocation - pSource );
+    return sView;
+}
+
+word_view_s 
+wordViewRange(
+    char const * const pBegin,
+    char const * const pEnd
+) {
+    word_view_s sView = { NULL, 0 };
+
+    if ( NULL == pBegin || pEnd < pBegin )
+    {
+        return sView;
+    }
+
+    sView.pString = pBegin;
+    sView.zLength = (size_t)( pEnd - pBegin );
+    return sView;
+}
+
+word_view_s 
+wordViewOf(
+    word_s const * const psRefs
+) {
+    word_view_s sView = { NULL, 0 };
+
+    if ( NULL == psRefs )
+    {
+        return sView;
+    }
+
+    sView.pString = psRefs->aString;
+    sView.zLength = psRefs->zLength - 1;
+    return sView;
 }
 
 void 
@@ -96,18 +254,550 @@ wordFree(
 ) {
     word_s * psRefs = (word_s *)( pvRefs );
 
+    if ( NULL == psRefs )
+    {
+        return;
+    }
+
+    if ( NULL == psRefs->psPool )
+    {
+        free(psRefs);
+        return;
+    }
+
+    poolErase(psRefs->psPool, psRefs);
+}
+
+word_builder_s * 
+wordBuilderMake(
+    pool_s * const psPool,
+    const size_t zCapacity
+) {
+    word_builder_s * psRefs = NULL;
+
+    psRefs = ( NULL == psPool ) ?
+        (word_builder_s *)malloc(sizeof(word_builder_s)) :
+        (word_builder_s *)poolAlloc(psPool, sizeof(word_builder_s)) ;
+    if ( NULL == psRefs )
+    {
+        return NULL;
+    }
+
+    *(void **)&psRefs->psPool = psPool;
+    psRefs->psWord = NULL;
+    psRefs->zCount = 0;
+    psRefs->zCapacity = 0;
+
+    if ( !_wordBuilderReserve(psRefs, ( zCapacity < WORD_BUILDER_MIN ) ? ( WORD_BUILDER_MIN ) : ( zCapacity ) ) )
+    {
+        wordBuilderFree(psRefs);
+        return NULL;
+    }
+
+    return psRefs;
+}
+
+void 
+wordBuilderFree(
+    void * pvRefs
+) {
+    word_builder_s * psRefs = (word_builder_s *)( pvRefs );
+
+    if ( NULL == psRefs )
+    {
+        return;
+    }
+
+    if ( NULL == psRefs->psPool )
+    {
+        free(psRefs->psWord);
+        free(psRefs);
+        return;
+    }
+
+    poolErase(psRefs->psPool, psRefs->psWord);
+    poolErase(psRefs->psPool, psRefs);
+}
+
+word_builder_s * 
+wordBuilderAppend(
+    word_builder_s * const psRefs,
+    char const * const pSource,
+    const size_t zCount
+) {
+    if ( NULL == psRefs || ( NULL == pSource && 0 != zCount ) || !_wordBuilderReserve(psRefs, zCount) )
+    {
+        return NULL;
+    }
+
+    memcpy(psRefs->psWord->aString + psRefs->zCount, pSource, zCount);
+    psRefs->zCount += zCount;
+
+    return psRefs;
+}
+
+word_builder_s * 
+wordBuilderAppendChar(
+    word_builder_s * const psRefs,
+    const char chr
+) {
+    if ( NULL == psRefs || !_wordBuilderReserve(psRefs, 1) )
+    {
+        return NULL;
+    }
+
+    psRefs->psWord->aString[ psRefs->zCount++ ] = chr;
+
+    return psRefs;
+}
+
+word_builder_s * 
+wordBuilderAppendFmt(
+    word_builder_s * const psRefs,
+    char const * const pFormat,
+    ...
+) {
+    va_list sArgs;
+    va_list sRetry;
+    int iCount = 0;
+
+    if ( NULL == psRefs || NULL == pFormat || !_wordBuilderReserve(psRefs, 0) )
+    {
+        return NULL;
+    }
+
+    // ? print straight into the free tail, only an output longer than the tail is printed twice
+    va_start(sArgs, pFormat);
+    va_copy(sRetry, sArgs);
+    iCount = vsnprintf(psRefs->psWord->aString + psRefs->zCount, psRefs->zCapacity - psRefs->zCount + 1, pFormat, sArgs);
+    va_end(sArgs);
+
+    if ( 0 > iCount )
+    {
+        // ! error: bad format
+        psRefs->psWord->aString[ psRefs->zCount ] = '\0';
+        va_end(sRetry);
+        return NULL;
+    }
+
+    if ( (size_t)iCount > psRefs->zCapacity - psRefs->zCount )
+    {
+        if ( !_wordBuilderReserve(psRefs, (size_t)iCount) )
+        {
+            va_end(sRetry);
+            return NULL;
+        }
+
+        vsnprintf(psRefs->psWord->aString + psRefs->zCount, (size_t)iCount + 1, pFormat, sRetry);
+    }
+    va_end(sRetry);
+
+    psRefs->zCount += (size_t)iCount;
+
+    return psRefs;
+}
+
+word_builder_s * 
+wordBuilderAppendInt(
+    word_builder_s * const psRefs,
+    const long long iValue
+) {
+    char aDigit[ 24 ];
+    char * pCurr = aDigit + sizeof(aDigit);
+    unsigned long long uValue = ( 0 > iValue ) ? ( 0ull - (unsigned long long)iValue ) : (unsigned long long)iValue ;
+
+    // ? digits from the back, no format string to parse
+    do
+    {
+        *--pCurr = (char)( '0' + uValue % 10 );
+        uValue /= 10;
+    } while ( 0 != uValue );
+
+    if ( 0 > iValue )
+    {
+        *--pCurr = '-';
+    }
+
+    return wordBuilderAppend(psRefs, pCurr, (size_t)( aDigit + sizeof(aDigit) - pCurr ));
+}
+
+word_view_s 
+wordBuilderView(
+    word_builder_s const * const psRefs
+) {
+    word_view_s sView = { NULL, 0 };
+
+    if ( NULL == psRefs || NULL == psRefs->psWord )
+    {
+        return sView;
+    }
+
+    sView.pString = psRefs->psWord->aString;
+    sView.zLength = psRefs->zCount;
+    return sView;
+}
+
+word_s * 
+wordBuilderFinish(
+    word_builder_s * const psRefs
+) {
+    word_s * psWord = NULL;
+
+    if ( NULL == psRefs || !_wordBuilderReserve(psRefs, 0) )
+    {
+        return NULL;
+    }
+
+    // ? give back the unused tail, then the builder starts over on a fresh block at its next append
+    psWord = _wordBlock(psRefs->psPool, psRefs->psWord, psRefs->zCount);
+    if ( NULL == psWord )
+    {
+        psWord = psRefs->psWord;
+    }
+
+    psWord->zLength = 1 + psRefs->zCount;
+    psWord->uHash = _wordHash(psWord->aString, psRefs->zCount);
+    psWord->aString[ psRefs->zCount ] = '\0';
+    *(void **)&psWord->psPool = psRefs->psPool;
+
+    psRefs->psWord = NULL;
+    psRefs->zCount = 0;
+    psRefs->zCapacity = 0;
+
+    return psWord;
+}
+
+word_intern_s * 
+wordInternMake(
+    pool_s * const psPool
+) {
+    word_intern_s * psRefs = NULL;
+
+    if ( NULL == psPool )
+    {
+        return NULL;
+    }
+
+    psRefs = (word_intern_s *)poolAlloc(psPool, sizeof(word_intern_s));
+    if ( NULL == psRefs )
+    {
+        return NULL;
+    }
+
+    psRefs->asSlot = (slot_s *)poolAlloc(psPool, WORD_INTERN_MIN * sizeof(slot_s));
+    if ( NULL == psRefs->asSlot )
+    {
+        poolErase(psPool, psRefs);
+        return NULL;
+    }
+
+    memset(psRefs->asSlot, 0, WORD_INTERN_MIN * sizeof(slot_s));
+    psRefs->zMask = WORD_INTERN_MIN - 1;
+    psRefs->zCount = 0;
+
+    *(void **)&psRefs->psPool = psPool;
+
+    return psRefs;
+}
+
+void 
+wordInternFree(
+    void * pvRefs
+) {
+    word_intern_s * psRefs = (word_intern_s *)( pvRefs );
+    size_t idx = 0;
+
+    if ( NULL == psRefs )
+    {
+        return;
+    }
+
+    for ( idx = 0; idx <= psRefs->zMask; ++idx )
+    {
+        wordFree(psRefs->asSlot[ idx ].psWord);
+    }
+
+    poolErase(psRefs->psPool, psRefs->asSlot);
+    poolErase(psRefs->psPool, psRefs);
+}
+
+word_s const * 
+wordIntern(
+    word_intern_s * const psRefs,
+    const word_view_s sView
+) {
+    uint64_t uHash = 0;
+    slot_s * psSlot = NULL;
+    size_t idx = 0;
+
+    if ( NULL == psRefs || NULL == sView.pString )
+    {
+        return NULL;
+    }
+
+    // ? grow before probing, so the probe below always ends on a match or an empty slot
+    if ( 4 * ( psRefs->zCount + 1 ) > 3 * ( psRefs->zMask + 1 ) && !_wordInternGrow(psRefs) )
+    {
+        return NULL;
+    }
+
+    uHash = _wordHash(sView.pString, sView.zLength);
+    for ( idx = uHash & psRefs->zMask; NULL != psRefs->asSlot[ idx ].psWord; idx = ( idx + 1 ) & psRefs->zMask )
+    {
+        psSlot = &psRefs->asSlot[ idx ];
+        if ( uHash == psSlot->uHash && sView.zLength + 1 == psSlot->psWord->zLength && 0 == memcmp(sView.pString, psSlot->psWord->aString, sView.zLength) )
+        {
+            return psSlot->psWord;
+        }
+    }
+
+    psSlot = &psRefs->asSlot[ idx ];
+    psSlot->psWord = _wordDup(psRefs->psPool, sView.pString, sView.zLength);
+    if ( NULL == psSlot->psWord )
+    {
+        return NULL;
+    }
+
+    psSlot->uHash = psSlot->psWord->uHash;
+    ++psRefs->zCount;
+
+    return psSlot->psWord;
+}
+
+size_t 
+wordInternCount(
+    word_intern_s const * const psRefs
+) {
+    return ( NULL == psRefs ) ? ( 0 ) : ( psRefs->zCount ) ;
+}
+
+uint64_t 
+wordHash(
+    word_s const * const psRefs
+) {
+    return ( NULL == psRefs ) ? ( 0 ) : ( psRefs->uHash ) ;
+}
+
+uint64_t 
+wordViewHash(
+    const word_view_s sView
+) {
+    return ( NULL == sView.pString ) ? ( 0 ) : _wordHash(sView.pString, sView.zLength) ;
+}
+
+bool 
+wordEqual(
+    word_s const * const psLeft,
+    word_s const * const psRight
+) {
+    if ( psLeft == psRight )
+    {
+        return true;
+    }
+
+    // ? the length and the hash reject nearly every mismatch before the bytes are read
+    if ( NULL == psLeft || NULL == psRight || psLeft->zLength != psRight->zLength || psLeft->uHash != psRight->uHash )
+    {
+        return false;
+    }
+
+    return 0 == memcmp(psLeft->aString, psRight->aString, psLeft->zLength - 1);
+}
+
+int 
+wordCompare(
+    word_s const * const psLeft,
+    word_s const * const psRight
+) {
+    int iResult = 0;
+
+    if ( psLeft == psRight )
+    {
+        return 0;
+    }
+
+    if ( NULL == psLeft || NULL == psRight )
+    {
+        return ( NULL == psLeft ) ? ( -1 ) : ( 1 ) ;
+    }
+
+    // ? the hash carries no order, so only the same word skips the bytes
+    // ? the text may hold NUL bytes, so the terminators are left out and a prefix sorts first by its length
+    iResult = memcmp(psLeft->aString, psRight->aString, ( ( psLeft->zLength < psRight->zLength ) ? ( psLeft->zLength ) : ( psRight->zLength ) ) - 1);
+    if ( 0 != iResult )
+    {
+        return iResult;
+    }
+
+    return ( psLeft->zLength > psRight->zLength ) - ( psLeft->zLength < psRight->zLength );
+}
+
+bool 
+wordUtf8Valid(
+    const word_view_s sView
+) {
+    unsigned char const * const pSource = (unsigned char const *)sView.pString;
+    size_t zDone = 0;
+
+    if ( NULL == pSource )
+    {
+        return false;
+    }
+
+#ifdef WORD_UTF8_SIMD
+    // ? the vector check needs ssse3 for its table lookups, the rest of the bytes go through the scalar check
+    if ( __builtin_cpu_supports("ssse3") )
+    {
+        zDone = _wordUtf8CheckSimd(pSource, sView.zLength);
+        if ( SIZE_MAX == zDone )
+        {
+            return false;
+        }
+    }
+#endif
+
+    return sView.zLength == zDone + _wordUtf8Check(pSource + zDone, sView.zLength - zDone);
+}
+
+size_t 
+wordUtf8Count(
+    const word_view_s sView
+) {
+    signed char const * const pSource = (signed char const *)sView.pString;
+    size_t zResult = 0;
+    size_t idx = 0;
+#ifdef __SSE2__
+    __m128i sCount;
+    __m128i sBytes;
+    size_t zRound = 0;
+#endif
+
+    if ( NULL == pSource )
+    {
+        return 0;
+    }
+
+    // ? a codepoint is every byte that is not a continuation, 10xxxxxx reads below -64 as signed
+#ifdef __SSE2__
+    while ( sView.zLength - idx >= 16 )
+    {
+        sCount = _mm_setzero_si128();
+        for ( zRound = 0; zRound < 255 && sView.zLength - idx >= 16; ++zRound, idx += 16 )
+        {
+            sBytes = _mm_loadu_si128((__m128i const *)( pSource + idx ));
+            sCount = _mm_sub_epi8(sCount, _mm_cmpgt_epi8(sBytes, _mm_set1_epi8(-65)));
+        }
+
+        sCount = _mm_sad_epu8(sCount, _mm_setzero_si128());
+        zResult += (size_t)_mm_cvtsi128_si32(sCount) + (size_t)_mm_extract_epi16(sCount, 4);
+    }
+#endif
+
+    for ( ; idx < sView.zLength; ++idx )
+    {
+        zResult += ( pSource[ idx ] > -65 );
+    }
+
+    return zResult;
+}
+
+word_index_s * 
+wordIndexMake(
+    pool_s * const psPool,
+    word_s const * const psWord
+) {
+    word_index_s * psRefs = NULL;
+    size_t zCount = 0;
+    size_t zOffset = 0;
+    size_t idx = 0;
+
+    if ( NULL == psPool || NULL == psWord || !wordUtf8Valid(wordViewOf(psWord)) )
+    {
+        return NULL;
+    }
+
+    zCount = wordUtf8Count(wordViewOf(psWord));
+    psRefs = (word_index_s *)poolAlloc(psPool, sizeof(word_index_s) + ( 1 + zCount / WORD_INDEX_STEP ) * sizeof(size_t));
+    if ( NULL == psRefs )
+    {
+        return NULL;
+    }
+
+    *(void **)&psRefs->psPool = psPool;
+    psRefs->psWord = psWord;
+    psRefs->zCount = zCount;
+
+    // ? record the lead byte of every WORD_INDEX_STEP-th codepoint
+    for ( zOffset = 0, zCount = 0; zOffset < psWord->zLength - 1; ++zOffset )
+    {
+        if ( 0x80 != ( 0xC0 & (unsigned char)psWord->aString[ zOffset ] ) && 0 == zCount++ % WORD_INDEX_STEP )
+        {
+            psRefs->azOffset[ idx++ ] = zOffset;
+        }
+    }
+
+    if ( 0 == psRefs->zCount )
+    {
+        psRefs->azOffset[ 0 ] = 0;
+    }
+
+    return psRefs;
+}
+
+void 
+wordIndexFree(
+    void * pvRefs
+) {
+    word_index_s * psRefs = (word_index_s *)( pvRefs );
+
     if ( NULL != psRefs )
     {
-        poolErase(psRefs->psPool, psRefs->pString);
         poolErase(psRefs->psPool, psRefs);
     }
 }
 
+size_t 
+wordIndexOffset(
+    word_index_s const * const psRefs,
+    const size_t zCodepoint
+) {
+    unsigned char const * pString = NULL;
+    size_t zOffset = 0;
+    size_t zSkip = 0;
+
+    if ( NULL == psRefs || zCodepoint > psRefs->zCount )
+    {
+        return SIZE_MAX;
+    }
+
+    if ( zCodepoint == psRefs->zCount )
+    {
+        return psRefs->psWord->zLength - 1;
+    }
+
+    // ? jump to the recorded codepoint, then step over at most WORD_INDEX_STEP - 1 sequences
+    pString = (unsigned char const *)psRefs->psWord->aString;
+    zOffset = psRefs->azOffset[ zCodepoint / WORD_INDEX_STEP ];
+    for ( zSkip = zCodepoint % WORD_INDEX_STEP; 0 < zSkip; --zSkip )
+    {
+        for ( ++zOffset; 0x80 == ( 0xC0 & pString[ zOffset ] ); ++zOffset ) { }
+    }
+
+    return zOffset;
+}
+
+size_t 
+wordIndexCount(
+    word_index_s const * const psRefs
+) {
+    return ( NULL == psRefs ) ? ( 0 ) : ( psRefs->zCount ) ;
+}
+
 char const * 
 wordAccess(
     word_s const * const psRefs
 ) {
-    return ( NULL == psRefs ) ? ( NULL ) : ( psRefs->pString ) ;
+    return ( NULL == psRefs ) ? ( NULL ) : ( psRefs->aString ) ;
 }
 
 size_t 
@@ -116,3 +806,351 @@ wordLength(
 ) {
     return ( NULL == psRefs ) ? ( NULL ) : ( psRefs->zLength ) ;
 }
+
+/* private */
+
+static
+word_s *
+_wordDup(
+    pool_s * const psPool,
+    char const * const pSource,
+    const size_t zCount
+) {
+    word_s * psRefs = NULL;
+
+    // ? copies exactly zCount bytes, the callers already know where the word ends
+    psRefs = (word_s *)poolAlloc(psPool, sizeof(word_s) + 1 + zCount);
+    if ( NULL == psRefs )
+    {
+        return NULL;
+    }
+
+    psRefs->zLength = 1 + zCount;
+    psRefs->uHash = _wordHash(pSource, zCount);
+    memcpy(psRefs->aString, pSource, zCount);
+    psRefs->aString[ zCount ] = '\0';
+
+    *(void **)&psRefs->psPool = psPool;
+
+    return psRefs;
+}
+
+static
+uint64_t
+_wordHash(
+    char const * const pSource,
+    const size_t zCount
+) {
+    static const uint64_t auSecret[] = {
+        UINT64_C(0xa0761d6478bd642f), UINT64_C(0xe7037ed1a0b428db),
+        UINT64_C(0x8ebc6af09c88c6db), UINT64_C(0x589965cc75374cc3)
+    };
+    unsigned char const * pCurr = (unsigned char const *)pSource;
+    uint64_t uSeed = _wordMix(auSecret[ 0 ], auSecret[ 1 ]);
+    uint64_t uSide = 0;
+    uint64_t uOther = 0;
+    uint64_t uLeft = 0;
+    uint64_t uRight = 0;
+    unsigned __int128 uProduct = 0;
+    size_t zRest = zCount;
+
+    // ? wyhash, a few 64 x 64 to 128 bit multiplies per 48 bytes and no table
+    if ( zCount <= 16 )
+    {
+        if ( zCount >= 4 )
+        {
+            uLeft = ( _wordRead(pCurr, 4) << 32 ) | _wordRead(pCurr + ( ( zCount >> 3 ) << 2 ), 4);
+            uRight = ( _wordRead(pCurr + zCount - 4, 4) << 32 ) | _wordRead(pCurr + zCount - 4 - ( ( zCount >> 3 ) << 2 ), 4);
+        }
+        else if ( zCount > 0 )
+        {
+            uLeft = ( (uint64_t)pCurr[ 0 ] << 16 ) | ( (uint64_t)pCurr[ zCount >> 1 ] << 8 ) | pCurr[ zCount - 1 ];
+        }
+    }
+    else
+    {
+        if ( zRest > 48 )
+        {
+            uSide = uSeed;
+            uOther = uSeed;
+            do
+            {
+                uSeed = _wordMix(_wordRead(pCurr, 8) ^ auSecret[ 1 ], _wordRead(pCurr + 8, 8) ^ uSeed);
+                uSide = _wordMix(_wordRead(pCurr + 16, 8) ^ auSecret[ 2 ], _wordRead(pCurr + 24, 8) ^ uSide);
+                uOther = _wordMix(_wordRead(pCurr + 32, 8) ^ auSecret[ 3 ], _wordRead(pCurr + 40, 8) ^ uOther);
+                pCurr += 48;
+                zRest -= 48;
+            } while ( zRest > 48 );
+            uSeed ^= uSide ^ uOther;
+        }
+
+        while ( zRest > 16 )
+        {
+            uSeed = _wordMix(_wordRead(pCurr, 8) ^ auSecret[ 1 ], _wordRead(pCurr + 8, 8) ^ uSeed);
+            pCurr += 16;
+            zRest -= 16;
+        }
+
+        uLeft = _wordRead(pCurr + zRest - 16, 8);
+        uRight = _wordRead(pCurr + zRest - 8, 8);
+    }
+
+    uProduct = (unsigned __int128)( uLeft ^ auSecret[ 1 ] ) * ( uRight ^ uSeed );
+    return _wordMix((uint64_t)uProduct ^ auSecret[ 0 ] ^ zCount, (uint64_t)( uProduct >> 64 ) ^ auSecret[ 1 ]);
+}
+
+static
+uint64_t
+_wordMix(
+    const uint64_t uLeft,
+    const uint64_t uRight
+) {
+    const unsigned __int128 uProduct = (unsigned __int128)uLeft * uRight;
+
+    return (uint64_t)uProduct ^ (uint64_t)( uProduct >> 64 );
+}
+
+static
+uint64_t
+_wordRead(
+    unsigned char const * const pSource,
+    const size_t zWidth
+) {
+    uint64_t uResult = 0;
+    uint32_t uHalf = 0;
+
+    // ? memcpy keeps the unaligned load legal, a little endian host is assumed like the pool files
+    if ( 8 == zWidth )
+    {
+        memcpy(&uResult, pSource, 8);
+        return uResult;
+    }
+
+    memcpy(&uHalf, pSource, 4);
+    return uHalf;
+}
+
+static
+bool
+_wordInternGrow(
+    word_intern_s * const psRefs
+) {
+    slot_s * const asOld = psRefs->asSlot;
+    const size_t zOld = psRefs->zMask + 1;
+    slot_s * asSlot = NULL;
+    size_t idx = 0;
+    size_t pos = 0;
+
+    asSlot = (slot_s *)poolAlloc(psRefs->psPool, 2 * zOld * sizeof(slot_s));
+    if ( NULL == asSlot )
+    {
+        return false;
+    }
+
+    memset(asSlot, 0, 2 * zOld * sizeof(slot_s));
+    for ( idx = 0; idx < zOld; ++idx )
+    {
+        if ( NULL == asOld[ idx ].psWord )
+        {
+            continue;
+        }
+
+        for ( pos = asOld[ idx ].uHash & ( 2 * zOld - 1 ); NULL != asSlot[ pos ].psWord; pos = ( pos + 1 ) & ( 2 * zOld - 1 ) ) { }
+        asSlot[ pos ] = asOld[ idx ];
+    }
+
+    psRefs->asSlot = asSlot;
+    psRefs->zMask = 2 * zOld - 1;
+    poolErase(psRefs->psPool, asOld);
+
+    return true;
+}
+
+static
+word_s *
+_wordBlock(
+    pool_s * const psPool,
+    word_s * const psWord,
+    const size_t zCapacity
+) {
+    // ? a pool block grows in place when its neighbour is free, the heap block goes through realloc
+    if ( NULL == psPool )
+    {
+        return (word_s *)realloc(psWord, sizeof(word_s) + zCapacity + 1);
+    }
+
+    return ( NULL == psWord ) ?
+        (word_s *)poolAlloc(psPool, sizeof(word_s) + zCapacity + 1) :
+        (word_s *)poolResize(psPool, psWord, sizeof(word_s) + zCapacity + 1) ;
+}
+
+static
+bool
+_wordBuilderReserve(
+    word_builder_s * const psRefs,
+    const size_t zCount
+) {
+    word_s * psWord = NULL;
+    size_t zCapacity = ( 0 == psRefs->zCapacity ) ? ( WORD_BUILDER_MIN ) : ( psRefs->zCapacity ) ;
+
+    if ( NULL != psRefs->psWord && zCount <= psRefs->zCapacity - psRefs->zCount )
+    {
+        return true;
+    }
+
+    if ( zCount > SIZE_MAX / 2 - sizeof(word_s) - psRefs->zCount )
+    {
+        // ! error: out of range
+        return false;
+    }
+
+    // ? doubling keeps appends amortized constant
+    while ( zCapacity < psRefs->zCount + zCount )
+    {
+        zCapacity *= 2;
+    }
+
+    psWord = _wordBlock(psRefs->psPool, psRefs->psWord, zCapacity);
+    if ( NULL == psWord )
+    {
+        return false;
+    }
+
+    psRefs->psWord = psWord;
+    psRefs->zCapacity = zCapacity;
+
+    return true;
+}
+
+static
+size_t
+_wordUtf8Check(
+    unsigned char const * const pSource,
+    const size_t zCount
+) {
+    size_t zOffset = 0;
+    size_t zWidth = 0;
+    uint32_t uPoint = 0;
+    size_t idx = 0;
+
+    // ? returns how many bytes form whole valid sequences, the caller compares it with zCount
+    while ( zOffset < zCount )
+    {
+        if ( pSource[ zOffset ] < 0x80 )
+        {
+            ++zOffset;
+            continue;
+        }
+
+        zWidth = ( pSource[ zOffset ] >= 0xF0 ) ? ( 4 ) : ( ( pSource[ zOffset ] >= 0xE0 ) ? ( 3 ) : ( 2 ) ) ;
+        if ( pSource[ zOffset ] < 0xC2 || pSource[ zOffset ] > 0xF4 || zWidth > zCount - zOffset )
+        {
+            return zOffset;
+        }
+
+        uPoint = pSource[ zOffset ] & ( 0x7F >> zWidth );
+        for ( idx = 1; idx < zWidth; ++idx )
+        {
+            if ( 0x80 != ( 0xC0 & pSource[ zOffset + idx ] ) )
+            {
+                return zOffset;
+            }
+            uPoint = ( uPoint << 6 ) | ( 0x3F & pSource[ zOffset + idx ] );
+        }
+
+        // ! error: overlong, surrogate or past U+10FFFF
+        if ( ( 3 == zWidth && uPoint < 0x800 ) || ( 4 == zWidth && uPoint < 0x10000 ) || ( uPoint >= 0xD800 && uPoint <= 0xDFFF ) || uPoint > 0x10FFFF )
+        {
+            return zOffset;
+        }
+
+        zOffset += zWidth;
+    }
+
+    return zOffset;
+}
+
+#ifdef WORD_UTF8_SIMD
+__attribute__((target("ssse3")))
+static
+size_t
+_wordUtf8CheckSimd(
+    unsigned char const * const pSource,
+    const size_t zCount
+) {
+    enum {
+        WUShort = 1 << 0, WULong = 1 << 1, WUOverlong3 = 1 << 2, WULarge = 1 << 3,
+        WUSurrogate = 1 << 4, WUOverlong2 = 1 << 5, WULarge1000 = 1 << 6, WUOverlong4 = 1 << 6,
+        WUTwoConts = 1 << 7, WUCarry = WUShort | WULong | WUTwoConts
+    };
+    const __m128i sHigh1 = _mm_setr_epi8(
+        WULong, WULong, WULong, WULong, WULong, WULong, WULong, WULong,
+        WUTwoConts, WUTwoConts, WUTwoConts, WUTwoConts,
+        WUShort | WUOverlong2, WUShort, WUShort | WUOverlong3 | WUSurrogate,
+        (char)( WUShort | WULarge | WULarge1000 | WUOverlong4 ));
+    const __m128i sLow1 = _mm_setr_epi8(
+        (char)( WUCarry | WUOverlong3 | WUOverlong2 | WUOverlong4 ), (char)( WUCarry | WUOverlong2 ), (char)WUCarry, (char)WUCarry,
+        (char)( WUCarry | WULarge ), (char)( WUCarry | WULarge | WULarge1000 ), (char)( WUCarry | WULarge | WULarge1000 ), (char)( WUCarry | WULarge | WULarge1000 ),
+        (char)( WUCarry | WULarge | WULarge1000 ), (char)( WUCarry | WULarge | WULarge1000 ), (char)( WUCarry | WULarge | WULarge1000 ), (char)( WUCarry | WULarge | WULarge1000 ),
+        (char)( WUCarry | WULarge | WULarge1000 ), (char)( WUCarry | WULarge | WULarge1000 | WUSurrogate ), (char)( WUCarry | WULarge | WULarge1000 ), (char)( WUCarry | WULarge | WULarge1000 ));
+    const __m128i sHigh2 = _mm_setr_epi8(
+        WUShort, WUShort, WUShort, WUShort, WUShort, WUShort, WUShort, WUShort,
+        (char)( WULong | WUOverlong2 | WUTwoConts | WUOverlong3 | WULarge1000 | WUOverlong4 ),
+        (char)( WULong | WUOverlong2 | WUTwoConts | WUOverlong3 | WULarge ),
+        (char)( WULong | WUOverlong2 | WUTwoConts | WUSurrogate | WULarge ),
+        (char)( WULong | WUOverlong2 | WUTwoConts | WUSurrogate | WULarge ),
+        WUShort, WUShort, WUShort, WUShort);
+    const __m128i sNibble = _mm_set1_epi8(0x0F);
+    __m128i sPrev = _mm_setzero_si128();
+    __m128i sInput;
+    __m128i sPrev1;
+    __m128i sSpecial;
+    __m128i sMust;
+    __m128i sError = _mm_setzero_si128();
+    size_t zOffset = 0;
+    size_t idx = 0;
+
+    // ? Keiser and Lemire, each byte pair is checked by three table lookups, the lead of a 3 or 4 byte sequence marks where continuations must follow
+    for ( zOffset = 0; zCount - zOffset >= 16; zOffset += 16 )
+    {
+        sInput = _mm_loadu_si128((__m128i const *)( pSource + zOffset ));
+        if ( 0 == _mm_movemask_epi8(_mm_or_si128(sInput, sPrev)) )
+        {
+            sPrev = sInput; /* ascii after ascii, nothing can be wrong */
+            continue;
+        }
+
+        sPrev1 = _mm_alignr_epi8(sInput, sPrev, 15);
+        sSpecial = _mm_and_si128(
+            _mm_and_si128(
+                _mm_shuffle_epi8(sHigh1, _mm_and_si128(_mm_srli_epi16(sPrev1, 4), sNibble)),
+                _mm_shuffle_epi8(sLow1, _mm_and_si128(sPrev1, sNibble))),
+            _mm_shuffle_epi8(sHigh2, _mm_and_si128(_mm_srli_epi16(sInput, 4), sNibble)));
+        sMust = _mm_or_si128(
+            _mm_subs_epu8(_mm_alignr_epi8(sInput, sPrev, 14), _mm_set1_epi8(0xE0 - 0x80)),
+            _mm_subs_epu8(_mm_alignr_epi8(sInput, sPrev, 13), _mm_set1_epi8((char)( 0xF0 - 0x80 ))));
+        sError = _mm_or_si128(sError, _mm_xor_si128(_mm_and_si128(sMust, _mm_set1_epi8((char)0x80)), sSpecial));
+        sPrev = sInput;
+    }
+
+    if ( 0xFFFF != _mm_movemask_epi8(_mm_cmpeq_epi8(sError, _mm_setzero_si128())) )
+    {
+        return SIZE_MAX;
+    }
+
+    // ? a sequence cut by the last block is left to the scalar check, so back up to its lead
+    for ( idx = 1; idx <= 3 && idx <= zOffset; ++idx )
+    {
+        if ( 0x80 != ( 0xC0 & pSource[ zOffset - idx ] ) )
+        {
+            if ( pSource[ zOffset - idx ] >= 0xC0 && ( pSource[ zOffset - idx ] >= 0xF0 ? 4 : ( pSource[ zOffset - idx ] >= 0xE0 ? 3 : 2 ) ) > idx )
+            {
+                return zOffset - idx;
+            }
+            break;
+        }
+    }
+
+    return zOffset;
+}
+#endif
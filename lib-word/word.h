@@ -5,19 +5,73 @@
 extern "C" {
 #endif /* __cplusplus */
 
+#include <stdbool.h>
+#include <stdint.h>
+
 #include "pool.h"
 
 #warning "Mush call poolErase() to free"
 
 typedef struct word_s word_s;
 
+typedef struct word_intern_s word_intern_s;
+
+typedef struct word_builder_s word_builder_s;
+
+typedef struct word_index_s word_index_s;
+
+/* borrows the bytes of another buffer, zLength has no terminator and pString is NULL when a view could not be made */
+typedef struct {
+    char const * pString;
+    size_t zLength;
+} word_view_s;
+
 word_s * wordDupAll(pool_s * const psPool, char const * const pSource);
 word_s * wordDupLen(pool_s * const psPool, char const * const pSource, const size_t zLength);
 word_s * wordDupChr(pool_s * const psPool, char const * const pSource, const char endChr);
 word_s * wordDupStr(pool_s * const psPool, char const * const pSource, char const * const pEndStr);
+word_s * wordDupRange(pool_s * const psPool, char const * const pBegin, char const * const pEnd);
+
+word_s * wordDupView(pool_s * const psPool, const word_view_s sView);
+
+word_view_s wordViewLen(char const * const pSource, const size_t zLength);
+word_view_s wordViewChr(char const * const pSource, const char endChr);
+word_view_s wordViewStr(char const * const pSource, char const * const pEndStr);
+word_view_s wordViewRange(char const * const pBegin, char const * const pEnd);
+word_view_s wordViewOf(word_s const * const psRefs);
 
 void wordFree(void * pvRefs);
 
+/* one canonical word per byte sequence, compare them by pointer and never wordFree them, wordInternFree drops them all */
+word_intern_s * wordInternMake(pool_s * const psPool);
+void wordInternFree(void * pvRefs);
+word_s const * wordIntern(word_intern_s * const psRefs, const word_view_s sView);
+size_t wordInternCount(word_intern_s const * const psRefs);
+
+/* the hash is made with the word, wordEqual rejects on length and hash before comparing bytes, wordCompare orders the bytes like memcmp, a prefix first, NUL bytes included */
+uint64_t wordHash(word_s const * const psRefs);
+uint64_t wordViewHash(const word_view_s sView);
+bool wordEqual(word_s const * const psLeft, word_s const * const psRight);
+int wordCompare(word_s const * const psLeft, word_s const * const psRight);
+
+/* a NULL pool builds on the heap, wordBuilderFinish hands the text off as a word_s and leaves the builder empty */
+word_builder_s * wordBuilderMake(pool_s * const psPool, const size_t zCapacity);
+void wordBuilderFree(void * pvRefs);
+word_builder_s * wordBuilderAppend(word_builder_s * const psRefs, char const * const pSource, const size_t zCount);
+word_builder_s * wordBuilderAppendChar(word_builder_s * const psRefs, const char chr);
+word_builder_s * wordBuilderAppendFmt(word_builder_s * const psRefs, char const * const pFormat, ...) __attribute__((format(printf, 2, 3)));
+word_builder_s * wordBuilderAppendInt(word_builder_s * const psRefs, const long long iValue);
+word_view_s wordBuilderView(word_builder_s const * const psRefs);
+word_s * wordBuilderFinish(word_builder_s * const psRefs);
+
+/* wordUtf8Count counts codepoints and expects valid text, an index maps codepoint offsets to byte offsets of a valid word it does not own */
+bool wordUtf8Valid(const word_view_s sView);
+size_t wordUtf8Count(const word_view_s sView);
+word_index_s * wordIndexMake(pool_s * const psPool, word_s const * const psWord);
+void wordIndexFree(void * pvRefs);
+size_t wordIndexOffset(word_index_s const * const psRefs, const size_t zCodepoint);
+size_t wordIndexCount(word_index_s const * const psRefs);
+
 char const * wordAccess(word_s const * const psRefs);
 size_t wordLength(word_s const * const psRefs);
 